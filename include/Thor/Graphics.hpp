@@ -29,9 +29,11 @@
 #ifndef THOR_MODULE_GRAPHICS_HPP
 #define THOR_MODULE_GRAPHICS_HPP
 
+#include <Thor/Graphics/AtlasBuilder.hpp>
 #include <Thor/Graphics/BigTexture.hpp>
 #include <Thor/Graphics/BigSprite.hpp>
 #include <Thor/Graphics/ColorGradient.hpp>
+#include <Thor/Graphics/ImageAtlas.hpp>
 #include <Thor/Graphics/ToString.hpp>
 #include <Thor/Graphics/UniformAccess.hpp>
 
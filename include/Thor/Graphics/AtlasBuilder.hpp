@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::AtlasBuilder
+
+#ifndef THOR_ATLASBUILDER_HPP
+#define THOR_ATLASBUILDER_HPP
+
+#include <Thor/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <map>
+#include <memory>
+#include <string>
+
+
+namespace sf
+{
+
+	class Image;
+
+} // namespace sf
+
+
+namespace thor
+{
+
+/// @addtogroup Graphics
+/// @{
+
+/// @brief Describes the images that are packed into a thor::ImageAtlas.
+/// @details Collects named images and image files, together with the packing parameters. The images are only loaded and packed
+///  when an atlas is loaded from the builder, see ImageAtlas::loadFromBuilder() and Resources::fromAtlasBuilder().
+/// @n@n Example:
+/// @code
+/// thor::AtlasBuilder builder;
+/// builder.addImageFile("player", "player.png");
+/// builder.addImageFile("enemy", "enemy.png");
+/// builder.addImage("spark", sparkImage);
+///
+/// thor::ImageAtlas atlas;
+/// atlas.loadFromBuilder(builder);
+/// texture.loadFromImage(atlas.getImage());
+/// particleSystem.addTextureRect(atlas.getTextureRect("spark"));
+/// @endcode
+class THOR_API AtlasBuilder
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates a builder without images, with a padding of 1 pixel and a maximal atlas size of 4096x4096 pixels.
+									AtlasBuilder();
+
+		/// @brief Adds an image to the atlas.
+		/// @details The image is copied. If an image with the same name has been added before, it is replaced.
+		/// @param name Name under which the image's rectangle can be looked up in the atlas.
+		/// @param image Image to pack.
+		void						addImage(const std::string& name, const sf::Image& image);
+
+		/// @brief Adds an image file to the atlas.
+		/// @details The file is loaded when the atlas is loaded. If an image with the same name has been added before, it is replaced.
+		/// @param name Name under which the image's rectangle can be looked up in the atlas.
+		/// @param filename Name of the image file.
+		void						addImageFile(const std::string& name, const std::string& filename);
+
+		/// @brief Sets the number of transparent pixels between two images.
+		/// @details Padding prevents neighbor images from bleeding into each other when textures are drawn with smoothing.
+		void						setPadding(unsigned int padding);
+
+		/// @brief Sets the size which the atlas image must not exceed.
+		/// @details Use sf::Texture::getMaximumSize() to make sure that the atlas can be loaded into a texture.
+		void						setMaximalSize(sf::Vector2u size);
+
+		/// @brief Returns the number of images added.
+		///
+		std::size_t					getImageCount() const;
+
+		/// @brief Removes all images.
+		/// @details The padding and the maximal size are kept.
+		void						clear();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private types
+	private:
+		// Image added directly (shared between copies of the builder), or file to load
+		struct Entry
+		{
+			std::shared_ptr<const sf::Image>	image;
+			std::string						filename;
+		};
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		std::map<std::string, Entry>	mEntries;
+		unsigned int				mPadding;
+		sf::Vector2u				mMaximalSize;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Friends
+	friend class ImageAtlas;
+};
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_ATLASBUILDER_HPP
@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::ImageAtlas
+
+#ifndef THOR_IMAGEATLAS_HPP
+#define THOR_IMAGEATLAS_HPP
+
+#include <Thor/Graphics/AtlasBuilder.hpp>
+#include <Thor/Config.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <map>
+#include <string>
+
+
+namespace thor
+{
+
+/// @addtogroup Graphics
+/// @{
+
+/// @brief Image that contains many smaller images.
+/// @details Packing many images into one allows to draw them from a single texture, which reduces texture switches. The rectangles
+///  of the images inside the atlas can be passed to sf::Sprite::setTextureRect(), ParticleSystem::addTextureRect() or
+///  FrameAnimation::addFrame().
+/// @n@n The atlas is built on the CPU and does not require an OpenGL context. It can be stored in a ResourceHolder and loaded
+///  on a background thread, see Resources::fromAtlasBuilder().
+class THOR_API ImageAtlas
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates an empty atlas.
+									ImageAtlas();
+
+		/// @brief Loads and packs the images of a builder.
+		/// @details Loads the image files, places the images without overlap and copies them into the atlas image. The images are
+		///  placed in order of decreasing size, each one at the free position which fits it most tightly (MaxRects algorithm with
+		///  best short side fit). The result only depends on the images and the builder's parameters, not on the platform.
+		/// @n@n The atlas image is as large as the bounding box of the packed images; areas not covered by images are transparent.
+		/// @return True if the atlas has been loaded. False if an image file cannot be loaded, or if the images do not fit into the
+		///  maximal size; in this case, the atlas remains unchanged.
+		bool						loadFromBuilder(const AtlasBuilder& builder);
+
+		/// @brief Returns the image containing all packed images.
+		///
+		const sf::Image&			getImage() const;
+
+		/// @brief Checks whether an image with the given name is packed in the atlas.
+		///
+		bool						hasTextureRect(const std::string& name) const;
+
+		/// @brief Returns the rectangle of a packed image, in pixels.
+		/// @param name Name of the image, as specified in the builder. The image must be packed in the atlas.
+		sf::IntRect					getTextureRect(const std::string& name) const;
+
+		/// @brief Returns the rectangles of all packed images, ordered by name.
+		///
+		const std::map<std::string, sf::IntRect>&	getTextureRects() const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		sf::Image									mImage;
+		std::map<std::string, sf::IntRect>			mTextureRects;
+};
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_IMAGEATLAS_HPP
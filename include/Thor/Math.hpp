@@ -31,9 +31,12 @@
 
 #include <Thor/Math/Distribution.hpp>
 #include <Thor/Math/Distributions.hpp>
+#include <Thor/Math/DynamicTriangulation.hpp>
 #include <Thor/Math/Random.hpp>
+#include <Thor/Math/StreamingTriangulation.hpp>
 #include <Thor/Math/Trigonometry.hpp>
 #include <Thor/Math/Triangulation.hpp>
 #include <Thor/Math/TriangulationFigures.hpp>
+#include <Thor/Math/TriangulationQuery.hpp>
 
 #endif // THOR_MODULE_MATH_HPP
@@ -0,0 +1,315 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <functional>
+#include <new>
+#include <utility>
+#include <cassert>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Sampling of built-in distributions, overloaded for the types supported by thor::Distributions
+	int THOR_API				sampleBuiltin(DistributionKind kind, int first, int second);
+	unsigned int THOR_API		sampleBuiltin(DistributionKind kind, unsigned int first, unsigned int second);
+	float THOR_API				sampleBuiltin(DistributionKind kind, float first, float second);
+	sf::Time THOR_API			sampleBuiltin(DistributionKind kind, sf::Time first, sf::Time second);
+	sf::Vector2f THOR_API		sampleBuiltin(DistributionKind kind, sf::Vector2f first, sf::Vector2f second);
+
+	// Other types only support constants
+	template <typename T>
+	T sampleBuiltin(DistributionKind kind, const T& first, const T&)
+	{
+		assert(kind == ConstantDistribution);
+		return first;
+	}
+
+	template <typename T>
+	T BuiltinParameters<T>::operator() () const
+	{
+		return sampleBuiltin(kind, first, second);
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Decides whether an object of type S is stored inside the buffer of type Buffer, or on the heap
+	template <typename S, typename Buffer>
+	struct FitsInline
+	{
+		static const bool value = sizeof(S) <= sizeof(Buffer)
+			&& std::alignment_of<Buffer>::value % std::alignment_of<S>::value == 0
+			&& std::is_nothrow_move_constructible<S>::value;
+	};
+
+	// Storage of an object of type S inside a buffer (Inline == true), or on the heap with a pointer in the buffer (Inline == false)
+	template <typename S, bool Inline>
+	struct InlineStorage;
+
+	template <typename S>
+	struct InlineStorage<S, true>
+	{
+		static S& get(void* storage)
+		{
+			return *static_cast<S*>(storage);
+		}
+
+		static const S& get(const void* storage)
+		{
+			return *static_cast<const S*>(storage);
+		}
+
+		static void create(void* storage, S&& object)
+		{
+			new (storage) S(std::move(object));
+		}
+
+		static void copy(const void* source, void* dest)
+		{
+			new (dest) S(get(source));
+		}
+
+		// Leaves source destroyed
+		static void move(void* source, void* dest)
+		{
+			S& object = get(source);
+
+			new (dest) S(std::move(object));
+			object.~S();
+		}
+
+		static void destroy(void* storage)
+		{
+			static_cast<S*>(storage)->~S();
+		}
+	};
+
+	template <typename S>
+	struct InlineStorage<S, false>
+	{
+		static S& get(void* storage)
+		{
+			return **static_cast<S**>(storage);
+		}
+
+		static const S& get(const void* storage)
+		{
+			return **static_cast<S* const*>(storage);
+		}
+
+		static void create(void* storage, S&& object)
+		{
+			*static_cast<S**>(storage) = new S(std::move(object));
+		}
+
+		static void copy(const void* source, void* dest)
+		{
+			*static_cast<S**>(dest) = new S(get(source));
+		}
+
+		// Leaves source destroyed
+		static void move(void* source, void* dest)
+		{
+			*static_cast<S**>(dest) = *static_cast<S**>(source);
+		}
+
+		static void destroy(void* storage)
+		{
+			delete *static_cast<S**>(storage);
+		}
+	};
+
+	// Function table for the stored object type S
+	template <typename T, typename S, typename Buffer>
+	struct StoredOperations
+	{
+		typedef InlineStorage<S, FitsInline<S, Buffer>::value> Storage;
+
+		// Like std::function, invoke functor as non-const
+		static T invoke(void* storage)
+		{
+			return Storage::get(storage)();
+		}
+
+		static const DistributionOperations<T> table;
+	};
+
+	template <typename T, typename S, typename Buffer>
+	const DistributionOperations<T> StoredOperations<T, S, Buffer>::table =
+	{
+		&StoredOperations::invoke,
+		&Storage::copy,
+		&Storage::move,
+		&Storage::destroy,
+	};
+
+	// Function table for moved-from distributions, which hold no object
+	template <typename T>
+	struct EmptyOperations
+	{
+		static T invoke(void*)
+		{
+			throw std::bad_function_call();
+		}
+
+		static void copy(const void*, void*)
+		{
+		}
+
+		static void move(void*, void*)
+		{
+		}
+
+		static void destroy(void*)
+		{
+		}
+
+		static const DistributionOperations<T> table;
+	};
+
+	template <typename T>
+	const DistributionOperations<T> EmptyOperations<T>::table =
+	{
+		&EmptyOperations::invoke,
+		&EmptyOperations::copy,
+		&EmptyOperations::move,
+		&EmptyOperations::destroy,
+	};
+
+	template <typename T>
+	Distribution<T> makeBuiltinDistribution(DistributionKind kind, const T& first, const T& second)
+	{
+		return Distribution<T>(kind, first, second);
+	}
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+template <typename T>
+Distribution<T>::Distribution(detail::DistributionKind kind, const T& first, const T& second)
+: mStorage()
+, mOperations(nullptr)
+, mKind(kind)
+{
+	Parameters parameters = {kind, first, second};
+	store(std::move(parameters));
+}
+
+template <typename T>
+Distribution<T>::Distribution(const Distribution& origin)
+: mStorage()
+, mOperations(origin.mOperations)
+, mKind(origin.mKind)
+{
+	mOperations->copy(&origin.mStorage, &mStorage);
+}
+
+template <typename T>
+Distribution<T>::Distribution(Distribution&& source)
+: mStorage()
+, mOperations(source.mOperations)
+, mKind(source.mKind)
+{
+	mOperations->move(&source.mStorage, &mStorage);
+	source.reset();
+}
+
+template <typename T>
+Distribution<T>& Distribution<T>::operator= (const Distribution& origin)
+{
+	// Copy-and-swap via move: stay consistent if copy throws
+	Distribution temp(origin);
+	return *this = std::move(temp);
+}
+
+template <typename T>
+Distribution<T>& Distribution<T>::operator= (Distribution&& source)
+{
+	if (this != &source)
+	{
+		mOperations->destroy(&mStorage);
+
+		mOperations = source.mOperations;
+		mKind = source.mKind;
+		mOperations->move(&source.mStorage, &mStorage);
+		source.reset();
+	}
+
+	return *this;
+}
+
+template <typename T>
+Distribution<T>::~Distribution()
+{
+	mOperations->destroy(&mStorage);
+}
+
+template <typename T>
+T Distribution<T>::operator() () const
+{
+	// Built-in kinds are dispatched by switch, only arbitrary functors need an indirect call
+	switch (mKind)
+	{
+		case detail::ConstantDistribution:
+			return getParameters().first;
+
+		case detail::FunctorDistribution:
+			return mOperations->invoke(&mStorage);
+
+		default:
+			return detail::sampleBuiltin(mKind, getParameters().first, getParameters().second);
+	}
+}
+
+template <typename T>
+template <typename S>
+void Distribution<T>::store(S object)
+{
+	typedef detail::StoredOperations<T, S, Buffer> Operations;
+
+	Operations::Storage::create(&mStorage, std::move(object));
+	mOperations = &Operations::table;
+}
+
+template <typename T>
+void Distribution<T>::reset()
+{
+	mOperations = &detail::EmptyOperations<T>::table;
+	mKind = detail::FunctorDistribution;
+}
+
+template <typename T>
+const typename Distribution<T>::Parameters& Distribution<T>::getParameters() const
+{
+	assert(mKind != detail::FunctorDistribution);
+	return detail::StoredOperations<T, Parameters, Buffer>::Storage::get(&mStorage);
+}
+
+} // namespace thor
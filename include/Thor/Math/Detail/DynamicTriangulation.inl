@@ -0,0 +1,47 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+
+template <typename OutputIterator>
+OutputIterator DynamicTriangulation::getTriangleIndices(OutputIterator indicesOut) const
+{
+	const std::vector<detail::TrIndex>& corners = mData.corners;
+
+	for (std::size_t e = 0; e < corners.size(); e += 3)
+	{
+		// Triangles at the boundary vertices only exist to support the algorithm
+		if (corners[e] < detail::BoundaryVertexCount || corners[e+1] < detail::BoundaryVertexCount || corners[e+2] < detail::BoundaryVertexCount)
+			continue;
+
+		for (std::size_t i = 0; i < 3; ++i)
+			*indicesOut++ = static_cast<std::uint32_t>(corners[e+i] - detail::BoundaryVertexCount);
+	}
+
+	return indicesOut;
+}
+
+} // namespace thor
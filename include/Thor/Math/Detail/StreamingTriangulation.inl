@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+
+template <typename OutputIterator>
+OutputIterator StreamingTriangulation::finalizeCell(unsigned int column, unsigned int row, OutputIterator indicesOut)
+{
+	assert(column < mData.columns && row < mData.rows);
+
+	detail::finalizeStreamingCell(mData, row * mData.columns + column);
+	return flushOutput(indicesOut);
+}
+
+template <typename OutputIterator>
+OutputIterator StreamingTriangulation::finish(OutputIterator indicesOut)
+{
+	detail::finishStreamingTriangulation(mData);
+	return flushOutput(indicesOut);
+}
+
+template <typename OutputIterator>
+OutputIterator StreamingTriangulation::flushOutput(OutputIterator indicesOut)
+{
+	indicesOut = std::copy(mData.output.begin(), mData.output.end(), indicesOut);
+	mData.output.clear();
+
+	return indicesOut;
+}
+
+} // namespace thor
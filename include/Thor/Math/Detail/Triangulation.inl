@@ -28,133 +28,6 @@ namespace thor
 namespace detail
 {
 
-	// Forward declarations
-	class AdvancedTriangle;
-	class AdvancedVertex;
-	class AdvancedEdge;
-
-	struct OptTriangleIterator;
-	struct OptTriangleItrArray;
-
-	// Functor to sort advanced vertices by their positions, needed to store them inside std::set.
-	struct THOR_API CompareVertexPtrs
-	{
-		bool operator() (const AdvancedVertex* lhs, const AdvancedVertex* rhs) const;
-	};
-
-	// Functor to sort constrained edges by their positions, needed to store them inside std::set.
-	struct THOR_API CompareEdges
-	{
-		bool operator() (const AdvancedEdge& lhs, const AdvancedEdge& rhs) const;
-	};
-
-	// Containers and iterators which don't depend on type directly
-	typedef std::set<AdvancedVertex*, CompareVertexPtrs>	VertexPtrSet;
-	typedef VertexPtrSet::iterator							VertexPtrIterator;
-
-	// ---------------------------------------------------------------------------------------------------------------------------
-
-
-	// Class to represent a vertex for algorithm internals
-	class THOR_API AdvancedVertex
-	{
-		// Note: Public interface contains OptTriangleIterator instead of TriangleIterator, although iterators are always valid.
-		// The reason is to avoid dependency on the STL container (TriangleIterator requires full typedef)
-		public:
-			template <typename V>
-										AdvancedVertex(V& userVertex, OptTriangleIterator surroundingTriangle);
-										AdvancedVertex(float x, float y);
-
-			sf::Vector2f				getPosition() const;
-			void						setSurroundingTriangle(OptTriangleIterator target);
-			OptTriangleIterator			getSurroundingTriangle() const;
-
-			template <typename V>
-			V&							getUserVertex() const;
-
-		private:
-			void*									mUserVertex;
-			sf::Vector2f							mPosition;
-			aurora::CopiedPtr<OptTriangleIterator>	mSurroundingTriangle;
-#ifndef NDEBUG
-			const std::type_info*					mUserType;
-#endif
-	};
-
-	// Meta-information edge, for algorithm internals
-	class THOR_API AdvancedEdge : public Edge<AdvancedVertex>
-	{
-		public:
-										AdvancedEdge(AdvancedVertex& startPoint, AdvancedVertex& endPoint);
-
-		private:
-			// Sorts the corners by vector-component-sum to allow faster access inside std::set.
-			void						orderCorners();
-	};
-
-	// A triangle that carries advanced information in order to efficiently support the algorithm.
-	class THOR_API AdvancedTriangle : public Triangle<AdvancedVertex>
-	{
-		public:
-										AdvancedTriangle(AdvancedVertex& corner0, AdvancedVertex& corner1, AdvancedVertex& corner2);
-
-			void						addVertex(AdvancedVertex& vertexRef);
-
-			void						removeVertex(AdvancedVertex& vertexRef);
-			void						removeVertex(VertexPtrIterator vertexItr);
-
-			VertexPtrIterator			begin();
-			VertexPtrIterator			end();
-
-			// Sets/returns the adjacent triangle on the opposite side of the corner #index.
-			void						setAdjacentTriangle(std::size_t index, const OptTriangleIterator& adjacentTriangle);
-			OptTriangleIterator			getAdjacentTriangle(std::size_t index) const;
-
-			// Marks this triangle (or removes mark)
-			void						setFlagged(bool flagged);
-			bool						isFlagged() const;
-
-		private:
-			VertexPtrSet							mRemainingVertices;
-			aurora::CopiedPtr<OptTriangleItrArray>	mAdjacentTriangles;
-			bool									mFlagged;
-	};
-
-	// ---------------------------------------------------------------------------------------------------------------------------
-
-
-	// Type definitions of containers
-	typedef std::deque<AdvancedVertex>						VertexCtr;
-	typedef std::set<AdvancedEdge, CompareEdges>			EdgeSet;
-	typedef std::list<AdvancedTriangle>						TriangleList;
-
-	// Type definitions of often used iterators
-	typedef TriangleList::iterator							TriangleIterator;
-
-	// ---------------------------------------------------------------------------------------------------------------------------
-
-
-	// Iterator to a triangle which can be explicitly invalid ("opt" stands for "optional").
-	struct THOR_API OptTriangleIterator
-	{
-									OptTriangleIterator();
-									OptTriangleIterator(TriangleIterator target);
-									OptTriangleIterator(const OptTriangleIterator& origin);
-		OptTriangleIterator&		operator= (const OptTriangleIterator& origin);
-
-		bool						valid;
-		TriangleIterator			target;
-	};
-
-	// Circle class, needed for circumcircle
-	struct Circle
-	{
-									Circle(sf::Vector2f midPoint, float squaredRadius);
-
-		sf::Vector2f				midPoint;
-		float						squaredRadius;
-	};
-
 	// Metafunction to get a CV-qualified iterator value type (std::iterator_traits<T>::value_type is not const)
 	template <typename T>
 	struct DereferencedIterator
@@ -167,40 +40,18 @@ namespace detail
 	// ---------------------------------------------------------------------------------------------------------------------------
 
 
-	template <typename V>
-	AdvancedVertex::AdvancedVertex(V& userVertex, OptTriangleIterator surroundingTriangle)
-	: mUserVertex(const_cast<typename std::remove_const<V>::type*>(&userVertex))
-	, mPosition(getVertexPosition(userVertex))
-	, mSurroundingTriangle(aurora::makeCopied<OptTriangleIterator>(surroundingTriangle))
-#ifndef NDEBUG
-	, mUserType(&typeid(V))
-#endif
+	// Policy class for small differences in triangulation - here for triangulate(), which may use multiple threads
+	struct DelaunayTrDetails
 	{
-	}
-
-	template <typename V>
-	V& AdvancedVertex::getUserVertex() const
-	{
-		assert(typeid(V) == *mUserType);
-		return *static_cast<V*>(mUserVertex);
-	}
-
-	// ---------------------------------------------------------------------------------------------------------------------------
-
-
-	// Function declarations required by the header
-	void 				THOR_API insertPoint(TriangleList& triangles, AdvancedVertex& vertex, const AdvancedTriangle& boundaryTriangle,
-									const EdgeSet& constrainedEdges);
-
-	void				THOR_API removeUnusedTriangles(TriangleList& triangles, const AdvancedTriangle& boundaryTriangle,
-									const EdgeSet& constrainedEdges, bool limitToPolygon);
-
-	void 				THOR_API createBoundaryPoints(VertexCtr& allVertices, TriangleList& triangles);
-
-	void 				THOR_API setBoundaryPositions(const VertexCtr& allVertices, AdvancedTriangle& boundaryTriangle);
+		explicit DelaunayTrDetails(ParallelTriangulationData& parallel)
+		: parallel(parallel)
+		{
+		}
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+		ParallelTriangulationData& parallel;
 
+		static const bool isPolygon = false;
+	};
 
 	// Policy class for small differences in triangulation - here for triangulateConstrained()
 	template <typename InputIterator>
@@ -248,182 +99,284 @@ namespace detail
 		return TriangulationTraits<V>::getPosition(vertex);
 	}
 
+	// Restores the type of a user vertex address that has been stored in the type-erased triangulation data.
+	template <typename UserVertex>
+	UserVertex& toUserVertex(const void* address)
+	{
+		return *static_cast<UserVertex*>(const_cast<void*>(address));
+	}
+
+	// Returns the user vertex that corresponds to a vertex index in the triangulation.
+	template <typename UserVertex>
+	UserVertex& getUserVertex(const TriangulationData& data, TrIndex vertex)
+	{
+		return toUserVertex<UserVertex>(data.userVertices[vertex - BoundaryVertexCount]);
+	}
+
+	// Appends a user vertex to the triangulation and returns its index. inputIndex is the vertex' offset in the input range.
+	template <typename UserVertex>
+	TrIndex addVertex(TriangulationData& data, UserVertex& vertex, TrIndex inputIndex)
+	{
+		data.positions.push_back(getVertexPosition(vertex));
+		data.userVertices.push_back(&vertex);
+		data.inputIndices.push_back(inputIndex);
+
+		return static_cast<TrIndex>(data.positions.size() - 1);
+	}
+
 	// Sort out vertices according to their "importance". Vertices that are part of a constrained edge shall be inserted first.
 	// Adds constrained edges as well.
-	template <typename InputIterator1, typename InputIterator2>
-	void collateVerticesConstrained(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
+	template <typename UserVertex, typename InputIterator1, typename InputIterator2>
+	void collateVerticesConstrained(TriangulationData& data,
 		InputIterator1 verticesBegin, InputIterator1 verticesEnd, InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd)
 	{
-		typedef typename DereferencedIterator<InputIterator1>::value_type UserVertex;
 		typedef typename std::iterator_traits<InputIterator2>::value_type UserEdge;
-		typedef std::set<UserVertex*> RawVertexPtrSet;
+		typedef std::less<const void*> CompareAddresses;
 
-		// Store pointers to important vertices in importantVertices set
-		RawVertexPtrSet importantVertices;
+		// Store pointers to important vertices, sorted by address to look them up
+		std::vector<const void*>& importantVertices = data.importantVertices;
 		for (InputIterator2 itr = constrainedEdgesBegin; itr != constrainedEdgesEnd; ++itr)
 		{
 			UserEdge& edge = *itr;
 
-			importantVertices.insert(&edge[0]);
-			importantVertices.insert(&edge[1]);
+			importantVertices.push_back(&edge[0]);
+			importantVertices.push_back(&edge[1]);
 		}
 
-		// Insert important advanced vertices, link to base triangle, fill user->advanced map
-		std::map<UserVertex*, AdvancedVertex*> map;
-		AURORA_FOREACH(UserVertex* userVertex, importantVertices)
-		{
-			allVertices.push_back(AdvancedVertex(*userVertex, firstTriangle));
-
-			AdvancedVertex& advancedVertex = allVertices.back();
-			firstTriangle->addVertex(advancedVertex);
+		std::sort(importantVertices.begin(), importantVertices.end(), CompareAddresses());
+		importantVertices.erase(std::unique(importantVertices.begin(), importantVertices.end()), importantVertices.end());
 
-			map.insert(std::make_pair(userVertex, &advancedVertex));
-		}
+		// Insert important vertices; their indices follow the order in importantVertices. Input indices are known later.
+		const TrIndex firstImportantIndex = static_cast<TrIndex>(data.positions.size());
+		for (std::size_t i = 0; i < importantVertices.size(); ++i)
+			addVertex(data, toUserVertex<UserVertex>(importantVertices[i]), InvalidTrIndex);
 
-		// Insert advanced edges, using the user->advanced map
+		// Insert constrained edges, mapping user vertices to indices
 		for (InputIterator2 itr = constrainedEdgesBegin; itr != constrainedEdgesEnd; ++itr)
 		{
 			UserEdge& userEdge = *itr;
 
-			AdvancedEdge advancedEdge(*map[&userEdge[0]], *map[&userEdge[1]]);
-			constrainedEdges.insert(advancedEdge);
+			TrIndex indices[2];
+			for (std::size_t i = 0; i < 2; ++i)
+			{
+				const void* address = &userEdge[i];
+				auto found = std::lower_bound(importantVertices.begin(), importantVertices.end(), address, CompareAddresses());
+				indices[i] = firstImportantIndex + static_cast<TrIndex>(found - importantVertices.begin());
+			}
+
+			data.constrainedEdges.push_back(std::make_pair(indices[0], indices[1]));
 		}
 
-		// Insert other vertices, link to base triangle
-		for (; verticesBegin != verticesEnd; ++verticesBegin)
+		// Insert other vertices, and remember the input index of important ones
+		for (TrIndex inputIndex = 0; verticesBegin != verticesEnd; ++verticesBegin, ++inputIndex)
 		{
 			UserVertex& userVertex = *verticesBegin;
+			const void* address = &userVertex;
 
-			if (importantVertices.find(&userVertex) == importantVertices.end())
-			{
-				allVertices.push_back(detail::AdvancedVertex(userVertex, firstTriangle));
-				firstTriangle->addVertex(allVertices.back());
-			}
+			auto found = std::lower_bound(importantVertices.begin(), importantVertices.end(), address, CompareAddresses());
+			if (found != importantVertices.end() && *found == address)
+				data.inputIndices[firstImportantIndex - BoundaryVertexCount + (found - importantVertices.begin())] = inputIndex;
+			else
+				addVertex(data, userVertex, inputIndex);
 		}
 	}
 
-	// Helper function for collateVerticesPolygon(); constructs an edge and adds it to the container and output iterator.
-	inline void addEdge(EdgeSet& constrainedEdges, AdvancedVertex* previousVertex, AdvancedVertex& currentVertex,
-		PolygonTrDetails)
+	// Helper function for collateVerticesPolygon(); adds an edge to the constrained edges.
+	inline void addEdge(TriangulationData& data, TrIndex previousVertex, TrIndex currentVertex, PolygonTrDetails&)
 	{
-		if (previousVertex != nullptr)
-			constrainedEdges.insert(AdvancedEdge(*previousVertex, currentVertex));
+		data.constrainedEdges.push_back(std::make_pair(previousVertex, currentVertex));
 	}
 
 	// Overload for PolygonOutputTrDetails to write in an output iterator
-	template <typename OutputIterator, typename UserVertex>
-	void addEdge(EdgeSet& constrainedEdges, AdvancedVertex* previousVertex, AdvancedVertex& currentVertex,
-		PolygonOutputTrDetails<OutputIterator, UserVertex> details)
+	template <typename UserVertex, typename OutputIterator>
+	void addEdge(TriangulationData& data, TrIndex previousVertex, TrIndex currentVertex,
+		PolygonOutputTrDetails<OutputIterator, UserVertex>& details)
 	{
-		if (previousVertex != nullptr)
-		{
-			*details.edgesOut++ = Edge<UserVertex>(
-				previousVertex->getUserVertex<UserVertex>(),
-				currentVertex.getUserVertex<UserVertex>());
+		*details.edgesOut++ = Edge<UserVertex>(
+			getUserVertex<UserVertex>(data, previousVertex),
+			getUserVertex<UserVertex>(data, currentVertex));
 
-			constrainedEdges.insert(AdvancedEdge(*previousVertex, currentVertex));
-		}
+		data.constrainedEdges.push_back(std::make_pair(previousVertex, currentVertex));
 	}
 
 	// collateVertices() - Implementation for polygons
 	template <typename InputIterator, class AdditionalDetails>
-	void collateVerticesPolygon(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator verticesBegin, InputIterator verticesEnd, const AdditionalDetails& details)
+	void collateVerticesPolygon(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, AdditionalDetails& details)
 	{
 		// Empty vertex range: Do nothing
 		if (verticesBegin == verticesEnd)
 			return;
 
-		AdvancedVertex* previousVertex = nullptr;
+		const TrIndex firstVertex = addVertex(data, *verticesBegin, 0);
+		TrIndex previousVertex = firstVertex;
 
-		for (; verticesBegin != verticesEnd; ++verticesBegin)
+		// Add each vertex together with the edge to its predecessor
+		TrIndex inputIndex = 1;
+		for (++verticesBegin; verticesBegin != verticesEnd; ++verticesBegin, ++inputIndex)
 		{
-			// Add the vertex to allVertices, link with firstTriangle
-			allVertices.push_back(AdvancedVertex(*verticesBegin, firstTriangle));
-			AdvancedVertex& vertex = allVertices.back();
-			firstTriangle->addVertex(vertex);
-
-			// Add edge of adjacent vertices
-			addEdge(constrainedEdges, previousVertex, vertex, details);
-			previousVertex = &vertex;
+			TrIndex vertex = addVertex(data, *verticesBegin, inputIndex);
+
+			addEdge(data, previousVertex, vertex, details);
+			previousVertex = vertex;
 		}
 
-		// If at least one vertex is contained, insert edge from last to first vertex, so that the boundary is closed.
-		// First vertex is the one directly inserted after the three boundary vertices.
-		AdvancedVertex& firstVertex = allVertices[3];
-		addEdge(constrainedEdges, previousVertex, firstVertex, details);
+		// Insert edge from last to first vertex, so that the boundary is closed.
+		if (previousVertex != firstVertex)
+			addEdge(data, previousVertex, firstVertex, details);
+	}
+
+	// Overload for DelaunayTrDetails: all vertices are equally important
+	template <typename InputIterator>
+	void collateVertices(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, DelaunayTrDetails&)
+	{
+		for (TrIndex inputIndex = 0; verticesBegin != verticesEnd; ++verticesBegin, ++inputIndex)
+			addVertex(data, *verticesBegin, inputIndex);
 	}
 
 	// Indirect overload for ConstrainedTrDetail<InputIterator2>
 	template <typename InputIterator1, typename InputIterator2>
-	void collateVertices(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator1 verticesBegin, InputIterator1 verticesEnd, const ConstrainedTrDetails<InputIterator2>& details)
+	void collateVertices(TriangulationData& data,
+		InputIterator1 verticesBegin, InputIterator1 verticesEnd, ConstrainedTrDetails<InputIterator2>& details)
 	{
-		collateVerticesConstrained(firstTriangle, allVertices, constrainedEdges, verticesBegin, verticesEnd,
+		typedef typename DereferencedIterator<InputIterator1>::value_type UserVertex;
+
+		collateVerticesConstrained<UserVertex>(data, verticesBegin, verticesEnd,
 			details.constrainedEdgesBegin, details.constrainedEdgesEnd);
 	}
 
 	// Indirect overload for PolygonTrDetails
 	template <typename InputIterator>
-	void collateVertices(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator verticesBegin, InputIterator verticesEnd, const PolygonTrDetails& details)
+	void collateVertices(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, PolygonTrDetails& details)
 	{
-		collateVerticesPolygon(firstTriangle, allVertices, constrainedEdges, verticesBegin, verticesEnd, details);
+		collateVerticesPolygon(data, verticesBegin, verticesEnd, details);
 	}
 
 	// Indirect overload for PolygonOutputTrDetails
-	template <typename InputIterator, typename OutputIterator, typename UserVertex>
-	void collateVertices(TriangleIterator firstTriangle, VertexCtr& allVertices, EdgeSet& constrainedEdges,
-		InputIterator verticesBegin, InputIterator verticesEnd, const PolygonOutputTrDetails<OutputIterator, UserVertex>& details)
+	template <typename UserVertex, typename InputIterator, typename OutputIterator>
+	void collateVertices(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, PolygonOutputTrDetails<OutputIterator, UserVertex>& details)
 	{
-		collateVerticesPolygon(firstTriangle, allVertices, constrainedEdges, verticesBegin, verticesEnd, details);
+		collateVerticesPolygon(data, verticesBegin, verticesEnd, details);
 	}
 
-	template <typename UserVertex, typename InputIterator, typename OutputIterator>
-	OutputIterator transformTriangles(InputIterator begin, InputIterator end, OutputIterator out)
+	template <typename UserVertex, typename OutputIterator>
+	OutputIterator transformTriangles(const TriangulationData& data, OutputIterator out)
 	{
-		for (; begin != end; ++begin)
+		for (std::size_t e = 0; e < data.corners.size(); e += 3)
 		{
-			const AdvancedTriangle& current = *begin;
-
-			// Downcast to original vertex type (during the algorithm, we abandoned full type information)
+			// Map indices back to original vertices (the boundary vertices are no longer part of any triangle)
 			*out++ = Triangle<UserVertex>(
-				current[0].getUserVertex<UserVertex>(),
-				current[1].getUserVertex<UserVertex>(),
-				current[2].getUserVertex<UserVertex>());
+				getUserVertex<UserVertex>(data, data.corners[e]),
+				getUserVertex<UserVertex>(data, data.corners[e+1]),
+				getUserVertex<UserVertex>(data, data.corners[e+2]));
 		}
 
 		return out;
 	}
 
-	template <typename InputIterator, typename OutputIterator, class AdditionalDetails>
-	OutputIterator triangulateImpl(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut, const AdditionalDetails& details)
+	// Writes three input indices per triangle
+	template <typename OutputIterator>
+	OutputIterator transformIndices(const TriangulationData& data, OutputIterator out)
 	{
-		// Create container for all vertices with additional implementation data (allVertices) and for triangles
-		VertexCtr		allVertices;
-		TriangleList	triangles;
-		EdgeSet			constrainedEdges;
+		for (std::size_t e = 0; e < data.corners.size(); ++e)
+			*out++ = static_cast<std::uint32_t>(data.inputIndices[data.corners[e] - BoundaryVertexCount]);
 
-		// Avoid reallocations (and thus iterator and reference invalidations), add first three boundary (dummy, as they're removed afterwards) vertices
-		createBoundaryPoints(allVertices, triangles);
-		AdvancedTriangle boundaryTriangle = triangles.front();
+		return out;
+	}
+
+	// Writes three neighbor triangle indices per triangle; edge i of a triangle connects its corners i and (i+1) % 3
+	template <typename OutputIterator>
+	OutputIterator transformAdjacency(const TriangulationData& data, OutputIterator out)
+	{
+		for (std::size_t e = 0; e < data.twins.size(); ++e)
+		{
+			const TrIndex twin = data.twins[e];
+			*out++ = static_cast<std::uint32_t>(twin == InvalidTrIndex ? NoAdjacentTriangle : twin / 3);
+		}
+
+		return out;
+	}
+
+	// Computes the triangulation for the given policy
+	template <class AdditionalDetails>
+	void computeTriangulation(TriangulationData& data, AdditionalDetails&)
+	{
+		computeTriangulation(data, AdditionalDetails::isPolygon);
+	}
+
+	// Overload for DelaunayTrDetails, which may distribute the work to multiple threads
+	inline void computeTriangulation(TriangulationData& data, DelaunayTrDetails& details)
+	{
+		computeParallelTriangulation(data, details.parallel);
+	}
+
+	// Computes the triangulation inside data, which is then ready to be transformed to the requested output
+	template <typename InputIterator, class AdditionalDetails>
+	void prepareTriangulation(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, AdditionalDetails& details)
+	{
+		// Mesh with the three boundary vertices; buffers of earlier triangulations keep their capacity
+		resetTriangulation(data);
 
 		// Bring vertices in ideal order for constrained Delaunay triangulation, and add constrained edges
-		collateVertices(triangles.begin(), allVertices, constrainedEdges, verticesBegin, verticesEnd, details);
+		collateVertices(data, verticesBegin, verticesEnd, details);
 
-		// Set the positions of the boundary vertices, according to the spread of the internal vertices
-		setBoundaryPositions(allVertices, boundaryTriangle);
+		// Insert all vertices and remove triangles that are not contained in the final triangulation
+		computeTriangulation(data, details);
+	}
 
-		// Insert each vertex. This invalidates the iterator first (because the old triangle is removed (split)).
-		for (VertexCtr::iterator itr = allVertices.begin() + 3, end = allVertices.end(); itr != end; ++itr)
-			insertPoint(triangles, *itr, boundaryTriangle, constrainedEdges);
+	template <typename InputIterator, typename OutputIterator, class AdditionalDetails>
+	OutputIterator triangulateImpl(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut, AdditionalDetails details)
+	{
+		typedef typename DereferencedIterator<InputIterator>::value_type UserVertex;
 
-		// Remove triangles that are not contained in the final triangulation
-		removeUnusedTriangles(triangles, boundaryTriangle, constrainedEdges, AdditionalDetails::isPolygon);
+		prepareTriangulation(data, verticesBegin, verticesEnd, details);
 
 		// Transform from algorithm-specific data structures to user interface
-		typedef typename DereferencedIterator<InputIterator>::value_type UserVertex;
-		return transformTriangles<UserVertex>(triangles.begin(), triangles.end(), trianglesOut);
+		return transformTriangles<UserVertex>(data, trianglesOut);
+	}
+
+	template <typename InputIterator, typename OutputIterator, class AdditionalDetails>
+	OutputIterator triangulateIndexedImpl(TriangulationData& data,
+		InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut, AdditionalDetails details)
+	{
+		prepareTriangulation(data, verticesBegin, verticesEnd, details);
+
+		return transformIndices(data, indicesOut);
+	}
+
+	// Type of the vertices in a user polygon (a range that can be passed to std::begin() and std::end())
+	template <typename UserPolygon>
+	struct PolygonVertex
+	{
+		typedef typename DereferencedIterator<decltype(std::begin(std::declval<UserPolygon&>()))>::value_type type;
+	};
+
+	// Adds the vertices and edges of a user polygon, for computeBatchTriangulation()
+	template <typename UserPolygon>
+	void collateBatchPolygon(TriangulationData& data, const void* polygon)
+	{
+		UserPolygon& userPolygon = *static_cast<UserPolygon*>(const_cast<void*>(polygon));
+
+		PolygonTrDetails details;
+		collateVerticesPolygon(data, std::begin(userPolygon), std::end(userPolygon), details);
+	}
+
+	// Triangulates all polygons of the range concurrently; the results are stored in batch
+	template <typename InputIterator>
+	void computeBatchTriangulation(BatchTriangulationData& batch, unsigned int threadCount, InputIterator polygonsBegin, InputIterator polygonsEnd)
+	{
+		typedef typename DereferencedIterator<InputIterator>::value_type UserPolygon;
+
+		batch.polygons.clear();
+		for (InputIterator itr = polygonsBegin; itr != polygonsEnd; ++itr)
+			batch.polygons.push_back(&*itr);
+
+		computeBatchTriangulation(batch, threadCount, &collateBatchPolygon<UserPolygon>);
 	}
 
 } // namespace detail
@@ -432,35 +385,196 @@ namespace detail
 
 
 template <typename InputIterator, typename OutputIterator>
-OutputIterator triangulate(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
+OutputIterator Triangulator::triangulate(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
+{
+	// Delaunay Triangulation == Constrained Delaunay Triangulation without constraining edges, but possibly parallel
+	return detail::triangulateImpl(mData, verticesBegin, verticesEnd, trianglesOut,
+		detail::DelaunayTrDetails(mParallel));
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator Triangulator::triangulateConstrained(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator trianglesOut)
+{
+	return detail::triangulateImpl(mData, verticesBegin, verticesEnd, trianglesOut,
+		detail::ConstrainedTrDetails<InputIterator2>(constrainedEdgesBegin, constrainedEdgesEnd));
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator Triangulator::triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
+{
+	return detail::triangulateImpl(mData, verticesBegin, verticesEnd, trianglesOut,
+		detail::PolygonTrDetails());
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 Triangulator::triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut, OutputIterator2 edgesOut)
+{
+	return detail::triangulateImpl(mData, verticesBegin, verticesEnd, trianglesOut,
+		detail::PolygonOutputTrDetails<OutputIterator2, typename detail::DereferencedIterator<InputIterator>::value_type>(edgesOut));
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator Triangulator::triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut)
+{
+	return detail::triangulateIndexedImpl(mData, verticesBegin, verticesEnd, indicesOut,
+		detail::DelaunayTrDetails(mParallel));
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 Triangulator::triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut)
+{
+	indicesOut = triangulateIndexed(verticesBegin, verticesEnd, indicesOut);
+	detail::transformAdjacency(mData, adjacencyOut);
+	return indicesOut;
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator Triangulator::triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator indicesOut)
+{
+	return detail::triangulateIndexedImpl(mData, verticesBegin, verticesEnd, indicesOut,
+		detail::ConstrainedTrDetails<InputIterator2>(constrainedEdgesBegin, constrainedEdgesEnd));
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 Triangulator::triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut)
+{
+	indicesOut = triangulateConstrainedIndexed(verticesBegin, verticesEnd, constrainedEdgesBegin, constrainedEdgesEnd, indicesOut);
+	detail::transformAdjacency(mData, adjacencyOut);
+	return indicesOut;
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator Triangulator::triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut)
+{
+	return detail::triangulateIndexedImpl(mData, verticesBegin, verticesEnd, indicesOut,
+		detail::PolygonTrDetails());
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 Triangulator::triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut)
+{
+	indicesOut = triangulatePolygonIndexed(verticesBegin, verticesEnd, indicesOut);
+	detail::transformAdjacency(mData, adjacencyOut);
+	return indicesOut;
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 Triangulator::triangulatePolygons(InputIterator polygonsBegin, InputIterator polygonsEnd, OutputIterator1 trianglesOut, OutputIterator2 triangleCountsOut)
+{
+	typedef typename detail::DereferencedIterator<InputIterator>::value_type UserPolygon;
+	typedef typename detail::PolygonVertex<UserPolygon>::type UserVertex;
+
+	detail::computeBatchTriangulation(mBatch, mParallel.threadCount, polygonsBegin, polygonsEnd);
+
+	for (std::size_t polygon = 0; polygon < mBatch.polygons.size(); ++polygon)
+	{
+		// Input indices refer to the polygon's vertex range, which need not be random-access
+		UserPolygon& userPolygon = *static_cast<UserPolygon*>(const_cast<void*>(mBatch.polygons[polygon]));
+
+		mBatch.vertices.clear();
+		AURORA_FOREACH(UserVertex& vertex, userPolygon)
+			mBatch.vertices.push_back(&vertex);
+
+		const detail::BatchPolygonResult& result = mBatch.results[polygon];
+		const std::vector<detail::TrIndex>& indices = mBatch.workers[result.worker].indices;
+
+		for (detail::TrIndex i = result.begin; i < result.end; i += 3)
+		{
+			*trianglesOut++ = Triangle<UserVertex>(
+				detail::toUserVertex<UserVertex>(mBatch.vertices[indices[i]]),
+				detail::toUserVertex<UserVertex>(mBatch.vertices[indices[i+1]]),
+				detail::toUserVertex<UserVertex>(mBatch.vertices[indices[i+2]]));
+		}
+
+		*triangleCountsOut++ = static_cast<std::uint32_t>((result.end - result.begin) / 3);
+	}
+
+	return trianglesOut;
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 Triangulator::triangulatePolygonsIndexed(InputIterator polygonsBegin, InputIterator polygonsEnd, OutputIterator1 indicesOut, OutputIterator2 triangleCountsOut)
 {
-	// Delaunay Triangulation == Constrained Delaunay Triangulation without constraining edges
-	typedef typename detail::DereferencedIterator<InputIterator>::value_type UserVertex;
+	detail::computeBatchTriangulation(mBatch, mParallel.threadCount, polygonsBegin, polygonsEnd);
+
+	AURORA_FOREACH(const detail::BatchPolygonResult& result, mBatch.results)
+	{
+		const std::vector<detail::TrIndex>& indices = mBatch.workers[result.worker].indices;
+		indicesOut = std::copy(indices.begin() + result.begin, indices.begin() + result.end, indicesOut);
 
-	std::vector<Edge<UserVertex>> noEdges;
-	return triangulateConstrained(verticesBegin, verticesEnd, noEdges.begin(), noEdges.end(), trianglesOut);
+		*triangleCountsOut++ = static_cast<std::uint32_t>((result.end - result.begin) / 3);
+	}
+
+	return indicesOut;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator triangulate(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
+{
+	return Triangulator().triangulate(verticesBegin, verticesEnd, trianglesOut);
 }
 
 template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
 OutputIterator triangulateConstrained(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
 	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator trianglesOut)
 {
-	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
-		detail::ConstrainedTrDetails<InputIterator2>(constrainedEdgesBegin, constrainedEdgesEnd));
+	return Triangulator().triangulateConstrained(verticesBegin, verticesEnd, constrainedEdgesBegin, constrainedEdgesEnd, trianglesOut);
 }
 
 template <typename InputIterator, typename OutputIterator>
 OutputIterator triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut)
 {
-	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
-		detail::PolygonTrDetails());
+	return Triangulator().triangulatePolygon(verticesBegin, verticesEnd, trianglesOut);
 }
 
 template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
 OutputIterator1 triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut, OutputIterator2 edgesOut)
 {
-	return detail::triangulateImpl(verticesBegin, verticesEnd, trianglesOut,
-		detail::PolygonOutputTrDetails<OutputIterator2, typename detail::DereferencedIterator<InputIterator>::value_type>(edgesOut));
+	return Triangulator().triangulatePolygon(verticesBegin, verticesEnd, trianglesOut, edgesOut);
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut)
+{
+	return Triangulator().triangulateIndexed(verticesBegin, verticesEnd, indicesOut);
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut)
+{
+	return Triangulator().triangulateIndexed(verticesBegin, verticesEnd, indicesOut, adjacencyOut);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator indicesOut)
+{
+	return Triangulator().triangulateConstrainedIndexed(verticesBegin, verticesEnd, constrainedEdgesBegin, constrainedEdgesEnd, indicesOut);
+}
+
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+	InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut)
+{
+	return Triangulator().triangulateConstrainedIndexed(verticesBegin, verticesEnd, constrainedEdgesBegin, constrainedEdgesEnd, indicesOut, adjacencyOut);
+}
+
+template <typename InputIterator, typename OutputIterator>
+OutputIterator triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut)
+{
+	return Triangulator().triangulatePolygonIndexed(verticesBegin, verticesEnd, indicesOut);
+}
+
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1 triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut)
+{
+	return Triangulator().triangulatePolygonIndexed(verticesBegin, verticesEnd, indicesOut, adjacencyOut);
 }
 
 } // namespace thor
@@ -0,0 +1,289 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_TRIANGULATIONDATA_HPP
+#define THOR_TRIANGULATIONDATA_HPP
+
+#include <Thor/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Index of a vertex, triangle or half-edge inside TriangulationData
+	typedef std::uint32_t TrIndex;
+
+	// Marks a missing vertex, triangle or half-edge (e.g. no adjacent triangle)
+	const TrIndex InvalidTrIndex = static_cast<TrIndex>(-1);
+
+	// Number of boundary (dummy) vertices, which are stored before the user vertices
+	const TrIndex BoundaryVertexCount = 3;
+
+	// Strategy to find the triangle that contains a vertex about to be inserted
+	enum PointLocation
+	{
+		ConflictListLocation,	// Every triangle keeps a list of the remaining vertices inside it; vertices are inserted in input order
+		WalkingLocation			// Vertices are inserted in BRIO order (randomized rounds sorted along a Hilbert curve), and each one is
+								// located by walking from the triangle of the previously inserted vertex
+	};
+
+	// Axis-aligned bounding box
+	struct EdgeBox
+	{
+		sf::Vector2f								min;				// Lower corner
+		sf::Vector2f								max;				// Upper corner
+	};
+
+	// Packed R-tree over the constrained edges, to find the edges that a segment may intersect without testing all of them.
+	// The edges are sorted along a Hilbert curve and grouped into leaves of up to EdgeTreeFanout edges; each further level
+	// groups EdgeTreeFanout nodes of the level below. The levels are stored after each other, the root is the last box.
+	struct EdgeTree
+	{
+		std::vector<std::pair<sf::Vector2f, sf::Vector2f>>	segments;	// Endpoint positions of the constrained edges, in leaf order
+		std::vector<EdgeBox>						boxes;				// Bounding box of each node, level by level
+		std::vector<TrIndex>						levelBegins;		// Per level (plus one): index of the first box
+		std::vector<std::pair<TrIndex, TrIndex>>	stack;				// Level and index of the nodes to visit during a query
+	};
+
+	// Number of children of each node in EdgeTree
+	const TrIndex EdgeTreeFanout = 8;
+
+	// Flat, index-based triangle mesh on which the algorithm operates.
+	// Triangle t consists of the half-edges 3t, 3t+1 and 3t+2, in clockwise order. Half-edge e starts at vertex corners[e]
+	// and ends at the start of the next half-edge in the same triangle. twins[e] is the half-edge of the adjacent triangle
+	// that runs in the opposite direction, or InvalidTrIndex at the border. The first three vertices form a huge triangle
+	// that surrounds all other vertices; it is removed at the end.
+	struct THOR_API TriangulationData
+	{
+		// Constructor
+		TriangulationData();
+
+		// Options
+		PointLocation								pointLocation;		// How vertices are located during insertion
+		float										boundaryExtent;		// Minimal coordinate extent covered by the boundary triangle
+
+		// Input
+		std::vector<sf::Vector2f>					positions;			// Position of each vertex
+		std::vector<std::pair<TrIndex, TrIndex>>	constrainedEdges;	// Vertex indices of each constrained edge
+		std::vector<const void*>					userVertices;		// Address of the user vertex behind each non-boundary vertex
+		std::vector<const void*>					importantVertices;	// Sorted addresses of vertices in constrained edges
+		std::vector<TrIndex>						inputIndices;		// Offset in the input range of each non-boundary vertex
+
+		// Output: after computeTriangulation(), contains only the resulting triangles
+		std::vector<TrIndex>						corners;			// Start vertex of each half-edge
+		std::vector<TrIndex>						twins;				// Opposite half-edge of each half-edge
+		std::vector<TrIndex>						vertexEdges;		// Per vertex: a half-edge starting at the vertex (if any)
+
+		// Algorithm internals: each triangle stores an intrusive list of the vertices inside it that are not inserted yet
+		std::vector<TrIndex>						firstVertices;		// Per triangle: first remaining vertex
+		std::vector<TrIndex>						nextVertices;		// Per vertex: next remaining vertex in the same triangle
+		std::vector<TrIndex>						vertexTriangles;	// Per vertex: triangle that contains the vertex
+		std::vector<TrIndex>						pendingEdges;		// Half-edges to check for the Delaunay condition
+		std::vector<TrIndex>						insertionOrder;		// Order of vertex insertion (walking location only), also used for sorting edges
+		std::vector<std::uint32_t>					hilbertKeys;		// Per vertex or edge: index on the Hilbert curve, used for sorting
+		std::vector<std::pair<TrIndex, TrIndex>>	crossingEdges;		// Edges to flip while recovering a constrained edge
+		std::vector<bool>							removed;			// Per triangle: whether it is cut off at the end
+		std::vector<TrIndex>						neighborVertices;	// Constrained neighbors of a vertex that is moved (dynamic triangulation)
+		EdgeTree									edgeTree;			// Acceleration structure for intersection tests
+	};
+
+	// Vertical strip of vertices that is triangulated on its own during a parallel triangulation
+	struct TriangulationPart
+	{
+		TriangulationData							data;				// Triangulation of the strip; inputIndices contain vertex indices of the whole set
+		std::vector<TrIndex>						finalTriangles;		// Per triangle: index among the strip's final triangles, or InvalidTrIndex
+		std::vector<TrIndex>						seamVertices;		// Vertices of the non-final triangles and the strip's border
+		TrIndex										finalCount;			// Number of final triangles
+		TrIndex										firstFinal;			// Index of the first final triangle in the whole triangulation
+		float										minX;				// Smallest x coordinate of a vertex in the strip
+		float										maxX;				// Greatest x coordinate of a vertex in the strip
+	};
+
+	// Additional state for triangulations that are computed by several threads.
+	// The vertices are split into vertical strips of equal size, which are triangulated concurrently. A triangle of a strip whose
+	// circumcircle lies between the neighbor strips contains no other vertex and is final. The vertices of all other triangles are
+	// triangulated once more, constrained by the outline of the final triangles; the seam triangles outside of them complete the result.
+	struct ParallelTriangulationData
+	{
+		// Constructor
+		ParallelTriangulationData();
+
+		// Options
+		unsigned int								threadCount;		// Number of threads (0 = hardware concurrency)
+
+		// Algorithm internals
+		std::vector<TriangulationPart>				parts;				// Vertical strips, ordered by x coordinate
+		TriangulationData							seam;				// Triangulation of the vertices of non-final triangles
+		std::vector<TrIndex>						seamIndices;		// Per vertex: index in the seam triangulation, if any
+		std::vector<TrIndex>						seamTriangles;		// Per seam triangle: index in the whole triangulation, if any
+		std::vector<std::pair<TrIndex, TrIndex>>	outline;			// Start vertex and half-edge of the final region's outline, sorted
+		EdgeBox										bounds;				// Bounding box of all vertices
+	};
+
+	// Location of one polygon's triangles in a batch triangulation
+	struct BatchPolygonResult
+	{
+		TrIndex										worker;				// Thread that triangulated the polygon
+		TrIndex										begin;				// Index of the first corner in the worker's indices
+		TrIndex										end;				// Index behind the last corner
+	};
+
+	// Scratch memory of one thread in a batch triangulation
+	struct BatchWorker
+	{
+		TriangulationData							data;				// Triangulation of the polygon being processed
+		std::vector<TrIndex>						indices;			// Input indices of the triangle corners of all polygons of the thread
+	};
+
+	// Adds the vertices and edges of a user polygon (given by its address) to data
+	typedef void (*BatchCollateFunction)(TriangulationData& data, const void* polygon);
+
+	// State for the triangulation of many polygons at once. The polygons are distributed over threads, each of which triangulates
+	// them one after another with its own scratch memory. Afterwards, the results are written to the user's output in polygon order.
+	struct BatchTriangulationData
+	{
+		std::vector<BatchWorker>					workers;			// Per thread: scratch memory and results
+		std::vector<const void*>					polygons;			// Address of each user polygon
+		std::vector<BatchPolygonResult>				results;			// Per polygon: location of its triangles
+		std::vector<const void*>					vertices;			// Addresses of a polygon's vertices, while its triangles are written
+	};
+
+	// Delaunay triangulation that is kept for spatial queries. The mesh keeps the triangles at the boundary vertices, so that walks
+	// through it never reach a border; the other triangles are numbered for the user.
+	struct THOR_API TriangulationQueryData
+	{
+		TriangulationData							mesh;				// Triangulation including the boundary triangles
+		std::vector<TrIndex>						userTriangles;		// Per user triangle: index in the mesh
+		std::vector<TrIndex>						meshTriangles;		// Per mesh triangle: user index, or InvalidTrIndex at the boundary
+		std::vector<sf::Vector2f>					circumcenters;		// Per mesh triangle: center of the circumcircle
+		std::vector<TrIndex>						cells;				// Per grid cell: mesh triangle at which walks to a point begin
+		std::vector<TrIndex>						cellBegins;			// Per grid cell (plus one): index of the first vertex in cellVertices
+		std::vector<TrIndex>						cellVertices;		// Vertices sorted by grid cell
+		EdgeBox										bounds;				// Bounding box of the vertices, covered by the grid
+		sf::Vector2f								cellSize;			// Extent of a grid cell
+		TrIndex										columns;			// Number of grid cells in x direction
+		TrIndex										rows;				// Number of grid cells in y direction
+	};
+
+	// Streaming Delaunay triangulation over a grid of cells. The mesh only holds the active front: as soon as the circumcircle of a
+	// triangle touches only finalized cells, no further vertex can change it, and it is moved to the output. The triangles at the
+	// boundary vertices are kept until the end, since their shape does not follow the Delaunay condition. Vertex slots are reused.
+	struct THOR_API StreamingTriangulationData
+	{
+		TriangulationData							mesh;				// Active triangles, including those at the boundary vertices
+		std::vector<std::uint32_t>					vertexIds;			// Per vertex slot: index of the vertex in the input stream
+		std::vector<TrIndex>						freeVertices;		// Vertex slots that no triangle refers to
+		std::vector<char>							referenced;			// Per vertex slot: whether a triangle refers to it, during collection
+		std::vector<TrIndex>						triangleCells;		// Per triangle: unfinalized cell its circumcircle touches, or InvalidTrIndex
+		std::vector<std::vector<TrIndex>>			cellTriangles;		// Per cell: triangles waiting for it (may contain outdated entries)
+		std::vector<char>							finalizedCells;		// Per cell: whether no more vertices are inserted into it
+		std::vector<TrIndex>						cellVertices;		// Per cell: last vertex inserted into it, or InvalidTrIndex
+		std::vector<std::uint32_t>					output;				// Vertex indices of final triangles, not yet passed to the user
+		std::vector<TrIndex>						searchMarks;		// Per triangle: number of the last search that visited it
+		std::vector<TrIndex>						searchQueue;		// Triangles to visit during a search in a cell
+		EdgeBox										bounds;				// Region that contains all vertices, covered by the cells
+		sf::Vector2f								cellSize;			// Extent of a cell
+		TrIndex										columns;			// Number of cells in x direction
+		TrIndex										rows;				// Number of cells in y direction
+		TrIndex										lastTriangle;		// Triangle of the previous vertex, if the cell has no vertex yet
+		TrIndex										collectionSize;		// Number of vertex slots from which unreferenced ones are collected
+		TrIndex										searchNumber;		// Number of the current search in a cell
+		std::uint32_t								nextVertexId;		// Stream index of the next inserted vertex
+	};
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Resets data to contain only the three boundary vertices, keeping the allocated memory
+	void				THOR_API resetTriangulation(TriangulationData& data);
+
+	// Triangulates the vertices in data. Afterwards, corners and twins contain the resulting triangles.
+	void				THOR_API computeTriangulation(TriangulationData& data, bool limitToPolygon);
+
+	// Delaunay-triangulates the vertices in data (without constrained edges), using multiple threads for large vertex sets.
+	// The result is the same as for computeTriangulation(data, false), up to the order of triangles.
+	void				THOR_API computeParallelTriangulation(TriangulationData& data, ParallelTriangulationData& parallel);
+
+	// Triangulates each polygon in batch.polygons (collated by collate) on up to threadCount threads (0 = hardware concurrency)
+	void				THOR_API computeBatchTriangulation(BatchTriangulationData& batch, unsigned int threadCount, BatchCollateFunction collate);
+
+	// Dynamic triangulation: the mesh keeps the triangles at the boundary vertices, so that vertices and constrained edges can be
+	// inserted and removed one at a time. Removed vertices keep their slot in positions, but have no half-edge in vertexEdges.
+
+	// Triangulates the vertices that have a half-edge again from scratch, with a boundary triangle that covers boundaryExtent
+	void				rebuildDynamicTriangulation(TriangulationData& data);
+
+	// Inserts the vertex, whose position is already stored. The walk to its triangle may start at the vertex hint.
+	void				insertDynamicVertex(TriangulationData& data, TrIndex vertex, TrIndex hint);
+
+	// Removes the vertex and the constrained edges at it from the mesh
+	void				removeDynamicVertex(TriangulationData& data, TrIndex vertex);
+
+	// Moves the vertex to position, keeping the constrained edges at it
+	void				moveDynamicVertex(TriangulationData& data, TrIndex vertex, sf::Vector2f position);
+
+	// Inserts a constrained edge between two vertices of the mesh
+	void				insertDynamicEdge(TriangulationData& data, TrIndex start, TrIndex end);
+
+	// Removes a constrained edge; the edge may be flipped away afterwards
+	void				removeDynamicEdge(TriangulationData& data, TrIndex start, TrIndex end);
+
+	// Triangulates the vertices in query.mesh and prepares the structures for queries
+	void				THOR_API buildTriangulationQuery(TriangulationQueryData& query);
+
+	// Returns the mesh triangle that contains point (a boundary triangle if point is outside). The walk begins at the user triangle
+	// hint, if valid.
+	TrIndex				locateQueryTriangle(const TriangulationQueryData& query, sf::Vector2f point, TrIndex hint);
+
+	// Returns the vertex nearest to point, or InvalidTrIndex if there is no vertex
+	TrIndex				findNearestQueryVertex(const TriangulationQueryData& query, sf::Vector2f point);
+
+	// Starts a new stream whose vertices are inside bounds, which is divided into columns x rows cells
+	void				resetStreamingTriangulation(StreamingTriangulationData& stream, EdgeBox bounds, TrIndex columns, TrIndex rows);
+
+	// Returns the cell that contains position (clamped to the bounds)
+	TrIndex				getStreamingCell(const StreamingTriangulationData& stream, sf::Vector2f position);
+
+	// Inserts a vertex into a cell that is not finalized, and returns its stream index
+	std::uint32_t		insertStreamingVertex(StreamingTriangulationData& stream, sf::Vector2f position);
+
+	// Marks a cell as finalized and appends the triangles that became final to stream.output
+	void				THOR_API finalizeStreamingCell(StreamingTriangulationData& stream, TrIndex cell);
+
+	// Appends all remaining triangles to stream.output and starts a new stream with the same cells
+	void				THOR_API finishStreamingTriangulation(StreamingTriangulationData& stream);
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_TRIANGULATIONDATA_HPP
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+
+template <typename InputIterator>
+TriangulationQuery::TriangulationQuery(InputIterator verticesBegin, InputIterator verticesEnd)
+: mData()
+{
+	triangulate(verticesBegin, verticesEnd);
+}
+
+template <typename InputIterator>
+void TriangulationQuery::triangulate(InputIterator verticesBegin, InputIterator verticesEnd)
+{
+	detail::resetTriangulation(mData.mesh);
+
+	// Vertices are stored in input order, so vertex i + BoundaryVertexCount has the input index i
+	detail::TrIndex inputIndex = 0;
+	for (InputIterator itr = verticesBegin; itr != verticesEnd; ++itr)
+		detail::addVertex(mData.mesh, *itr, inputIndex++);
+
+	detail::buildTriangulationQuery(mData);
+}
+
+template <typename OutputIterator>
+OutputIterator TriangulationQuery::getVoronoiEdges(OutputIterator edgesOut) const
+{
+	const detail::TriangulationData& mesh = mData.mesh;
+
+	AURORA_FOREACH(detail::TrIndex t, mData.userTriangles)
+	{
+		for (detail::TrIndex e = 3*t; e < 3*t+3; ++e)
+		{
+			const detail::TrIndex twin = mesh.twins[e];
+			const detail::TrIndex neighbor = mData.meshTriangles[twin / 3];
+
+			// Edges between two triangles are visited twice, write them only once
+			if (neighbor != detail::InvalidTrIndex && twin < e)
+				continue;
+
+			const detail::TrIndex start = mesh.corners[e];
+			const detail::TrIndex end = mesh.corners[(e % 3 == 2) ? e - 2 : e + 1];
+
+			VoronoiEdge edge;
+			edge.vertices[0] = start - detail::BoundaryVertexCount;
+			edge.vertices[1] = end - detail::BoundaryVertexCount;
+			edge.start = mData.circumcenters[t];
+			edge.infinite = (neighbor == detail::InvalidTrIndex);
+
+			// At the border, the ray points away from the triangle, i.e. to the left of the clockwise half-edge
+			if (edge.infinite)
+				edge.end = unitVector(perpendicularVector(mesh.positions[end] - mesh.positions[start]));
+			else
+				edge.end = mData.circumcenters[twin / 3];
+
+			*edgesOut++ = edge;
+		}
+	}
+
+	return edgesOut;
+}
+
+template <typename OutputIterator>
+OutputIterator TriangulationQuery::getVoronoiCell(std::uint32_t vertex, OutputIterator cornersOut) const
+{
+	const detail::TriangulationData& mesh = mData.mesh;
+	assert(vertex + detail::BoundaryVertexCount < mesh.positions.size());
+
+	// Rotate clockwise around the vertex: the next half-edge is the twin of the previous one in the same triangle. If the cell is
+	// unbounded, begin behind a boundary triangle, so that the finite corners are contiguous.
+	const detail::TrIndex first = mesh.vertexEdges[vertex + detail::BoundaryVertexCount];
+	detail::TrIndex begin = first;
+	detail::TrIndex e = first;
+	do
+	{
+		detail::TrIndex next = mesh.twins[(e % 3 == 0) ? e + 2 : e - 1];
+		if (mData.meshTriangles[e / 3] == detail::InvalidTrIndex)
+		{
+			begin = next;
+			break;
+		}
+
+		e = next;
+	}
+	while (e != first);
+
+	e = begin;
+	do
+	{
+		if (mData.meshTriangles[e / 3] != detail::InvalidTrIndex)
+			*cornersOut++ = mData.circumcenters[e / 3];
+
+		e = mesh.twins[(e % 3 == 0) ? e + 2 : e - 1];
+	}
+	while (e != begin);
+
+	return cornersOut;
+}
+
+} // namespace thor
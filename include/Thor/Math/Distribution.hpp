@@ -29,10 +29,15 @@
 #ifndef THOR_DISTRIBUTION_HPP
 #define THOR_DISTRIBUTION_HPP
 
+#include <Thor/Config.hpp>
+
 #include <Aurora/Meta/Templates.hpp>
 
-#include <functional>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/System/Time.hpp>
+
 #include <type_traits>
+#include <utility>
 
 
 namespace thor
@@ -44,21 +49,35 @@ class Distribution;
 namespace detail
 {
 
-	// Functor that returns always the same value (don't use lambda expression because of Clang compiler bug)
+	// Kinds of distributions. All except FunctorDistribution are sampled directly, without indirect call.
+	enum DistributionKind
+	{
+		ConstantDistribution,	// Always the same value (first)
+		UniformDistribution,	// Uniform in the interval [first, second]
+		RectDistribution,		// Uniform in the rectangle with center first and half-size second
+		CircleDistribution,		// Uniform in the circle with center first and radius second.x
+		FunctorDistribution,	// Arbitrary callable
+	};
+
+	// Operations on the object stored inside a distribution (function table for type erasure)
 	template <typename T>
-	struct Constant
+	struct DistributionOperations
 	{
-		explicit Constant(T value)
-		: value(value)
-		{
-		}
+		T						(*invoke)(void* storage);
+		void					(*copy)(const void* source, void* dest);
+		void					(*move)(void* source, void* dest);
+		void					(*destroy)(void* storage);
+	};
 
-		T operator() () const
-		{
-			return value;
-		}
+	// Parameters of the built-in distributions created by thor::Distributions
+	template <typename T>
+	struct BuiltinParameters
+	{
+		DistributionKind		kind;
+		T						first;
+		T						second;
 
-		T value;
+		T operator() () const;
 	};
 
 	// Metafunction for SFINAE and reasonable compiler errors
@@ -76,6 +95,10 @@ namespace detail
 		static const bool value = std::is_convertible<U, T>::value;
 	};
 
+	// Creates a distribution of a built-in kind
+	template <typename T>
+	Distribution<T> makeBuiltinDistribution(DistributionKind kind, const T& first, const T& second);
+
 } // namespace detail
 
 // ---------------------------------------------------------------------------------------------------------------------------
@@ -96,13 +119,17 @@ namespace detail
 ///
 /// thor::Distribution<int> thorDistr(randomizer);
 /// @endcode
+/// @n Constants and the uniform, rect and circle distributions of thor::Distributions are recognized and sampled directly,
+///  without going through a function pointer. Small functors are stored inline without dynamic allocation.
 template <typename T>
 class Distribution
 {
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private types
 	private:
-		typedef std::function<T()> FactoryFn;
+		// Inline buffer for parameters and functors. Larger objects are allocated on the heap.
+		typedef typename std::aligned_storage<4 * sizeof(void*)>::type		Buffer;
+		typedef detail::BuiltinParameters<T>								Parameters;
 
 
 	// ---------------------------------------------------------------------------------------------------------------------------
@@ -113,8 +140,14 @@ class Distribution
 		template <typename U>
 									Distribution(U constant
 										AURORA_ENABLE_IF(std::is_convertible<U, T>::value))
-		: mFactory(detail::Constant<T>(constant))
+		: mStorage()
+		, mOperations(nullptr)
+		, mKind(detail::ConstantDistribution)
 		{
+			const T value(constant);
+
+			Parameters parameters = {detail::ConstantDistribution, value, value};
+			store(std::move(parameters));
 		}
 
 		/// @brief Construct from distribution function
@@ -123,26 +156,69 @@ class Distribution
 		template <typename Fn>
 									Distribution(Fn function
 										AURORA_ENABLE_IF(detail::IsCompatibleFunction<Fn, T>::value))
-		: mFactory(function)
+		: mStorage()
+		, mOperations(nullptr)
+		, mKind(detail::FunctorDistribution)
 		{
+			store(std::move(function));
 		}
 
+		/// @brief Copy constructor
+		///
+									Distribution(const Distribution& origin);
+
+		/// @brief Move constructor
+		/// @details @a source is left empty; it may only be destroyed or assigned to.
+									Distribution(Distribution&& source);
+
+		/// @brief Copy assignment operator
+		///
+		Distribution&				operator= (const Distribution& origin);
+
+		/// @brief Move assignment operator
+		/// @details @a source is left empty; it may only be destroyed or assigned to.
+		Distribution&				operator= (Distribution&& source);
+
+		/// @brief Destructor
+		///
+									~Distribution();
+
 		/// @brief Returns a value according to the distribution.
 		///
-		T							operator() () const
-		{
-			return mFactory();
-		}
+		T							operator() () const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Constructs a built-in distribution
+									Distribution(detail::DistributionKind kind, const T& first, const T& second);
+
+		// Stores object inside the buffer (or on the heap)
+		template <typename S>
+		void						store(S object);
+
+		// Leaves the distribution empty (after moving from it)
+		void						reset();
+
+		// Returns built-in parameters, requires mKind != FunctorDistribution
+		const Parameters&			getParameters() const;
+
+		template <typename U>
+		friend Distribution<U>		detail::makeBuiltinDistribution(detail::DistributionKind kind, const U& first, const U& second);
 
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private variables
 	private:
-		FactoryFn					mFactory;
+		mutable Buffer								mStorage;
+		const detail::DistributionOperations<T>*	mOperations;
+		detail::DistributionKind					mKind;
 };
 
 /// @}
 
 } // namespace thor
 
+#include <Thor/Math/Detail/Distribution.inl>
 #endif // THOR_DISTRIBUTION_HPP
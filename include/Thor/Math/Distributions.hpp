@@ -34,6 +34,17 @@
 
 #include <SFML/System/Vector2.hpp>
 #include <SFML/System/Time.hpp>
+#include <SFML/Config.hpp>
+
+#include <vector>
+
+
+namespace sf
+{
+
+	class Image;
+
+} // namespace sf
 
 
 namespace thor
@@ -75,6 +86,64 @@ namespace Distributions
 	///
 	Distribution<sf::Vector2f> THOR_API		deflect(sf::Vector2f direction, float maxRotation);
 
+	/// @brief %Uniform random distribution over the opaque pixels of an image
+	/// @param image Image used as a mask. Every pixel with an alpha value greater than @a alphaThreshold is chosen with the
+	///  same probability, all other pixels are never chosen. The image is evaluated once, later changes are not reflected.
+	/// @param topLeft Position of the image's top-left pixel corner.
+	/// @param alphaThreshold Pixels with an alpha value less or equal to this are considered transparent.
+	/// @details Returned positions are uniformly distributed inside the chosen pixel, so they form no visible grid.
+	///  Pixels are looked up in an alias table, so a value is created in constant time, independent of image size and mask density.
+	/// @pre At least one pixel of @a image is opaque.
+	Distribution<sf::Vector2f> THOR_API		imageMask(const sf::Image& image, sf::Vector2f topLeft, sf::Uint8 alphaThreshold = 0);
+
+	/// @brief Random distribution over the pixels of an image, weighted by brightness
+	/// @param image Image used as a weight map. The probability of a pixel is proportional to its luminance multiplied with
+	///  its alpha value; black or fully transparent pixels are never chosen. The image is evaluated once, later changes are not reflected.
+	/// @param topLeft Position of the image's top-left pixel corner.
+	/// @details Like imageMask(), positions are spread uniformly inside the chosen pixel, and each value is created in constant time.
+	/// @pre At least one pixel of @a image is neither black nor fully transparent.
+	Distribution<sf::Vector2f> THOR_API		imageBrightness(const sf::Image& image, sf::Vector2f topLeft);
+
+	/// @brief Low-discrepancy distribution in a rectangle, based on the Halton sequence
+	/// @details Successive values cover the rectangle evenly instead of forming clusters and gaps, so fewer values are
+	///  required for a homogeneous look. The sequence is shifted by a random offset, so that different distributions don't
+	///  produce the same points. Copies of the returned distribution share and advance the same sequence.
+	Distribution<sf::Vector2f> THOR_API		haltonRect(sf::Vector2f center, sf::Vector2f halfSize);
+
+	/// @brief Low-discrepancy distribution in a circle, based on the Halton sequence
+	/// @details Area-preserving mapping of haltonRect() to a circle; see there for details.
+	Distribution<sf::Vector2f> THOR_API		haltonCircle(sf::Vector2f center, float radius);
+
+	/// @brief Low-discrepancy distribution in a rectangle, based on the Sobol sequence
+	/// @details Like haltonRect(), but uses the two-dimensional Sobol sequence, which is cheaper to compute and distributes
+	///  powers of two points particularly evenly. A random digital shift decorrelates different distributions.
+	///  Copies of the returned distribution share and advance the same sequence.
+	Distribution<sf::Vector2f> THOR_API		sobolRect(sf::Vector2f center, sf::Vector2f halfSize);
+
+	/// @brief Low-discrepancy distribution in a circle, based on the Sobol sequence
+	/// @details Area-preserving mapping of sobolRect() to a circle; see there for details.
+	Distribution<sf::Vector2f> THOR_API		sobolCircle(sf::Vector2f center, float radius);
+
+	/// @brief Random point set in a rectangle with a minimum distance between points (Poisson-disk sampling)
+	/// @param center,halfSize The rectangle to fill.
+	/// @param minDistance No two points are closer than this distance. Must be positive.
+	/// @return Points that fill the rectangle evenly, without any space left for another point. The number of points depends
+	///  on the area and @a minDistance.
+	/// @details Uses Bridson's algorithm, which requires linear time in the number of returned points.
+	std::vector<sf::Vector2f> THOR_API		poissonDiskRect(sf::Vector2f center, sf::Vector2f halfSize, float minDistance);
+
+	/// @brief Random point set in a circle with a minimum distance between points (Poisson-disk sampling)
+	/// @details See poissonDiskRect() for details.
+	std::vector<sf::Vector2f> THOR_API		poissonDiskCircle(sf::Vector2f center, float radius, float minDistance);
+
+	/// @brief Random point set in a polygon with a minimum distance between points (Poisson-disk sampling)
+	/// @param polygon Corners of a simple polygon (convex or concave), in any orientation. The edge between the last and
+	///  first corner closes the polygon.
+	/// @param minDistance No two points are closer than this distance. Must be positive.
+	/// @details See poissonDiskRect() for details. Parts of the polygon that are only connected through passages narrower
+	///  than @a minDistance may remain empty.
+	std::vector<sf::Vector2f> THOR_API		poissonDiskPolygon(const std::vector<sf::Vector2f>& polygon, float minDistance);
+
 } // namespace Distributions
 
 /// @}
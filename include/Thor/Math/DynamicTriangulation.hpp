@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::DynamicTriangulation
+
+#ifndef THOR_DYNAMICTRIANGULATION_HPP
+#define THOR_DYNAMICTRIANGULATION_HPP
+
+#include <Thor/Math/Detail/TriangulationData.hpp>
+#include <Thor/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <vector>
+#include <cstdint>
+
+
+namespace thor
+{
+
+/// @addtogroup Math
+/// @{
+
+/// @brief Constrained Delaunay Triangulation that can be edited vertex by vertex
+/// @details In contrast to thor::triangulateConstrained(), which computes a triangulation from scratch, this class keeps the
+///  triangulation between changes. Vertices and constrained edges can be inserted, removed and moved individually; only the triangles
+///  around the change are updated by local edge flips. This is useful for interactive applications such as editors, where a user
+///  drags single vertices of a large mesh.
+/// @n Vertices are referred to by identifiers, which are also used in the output of getTriangleIndices(). A vertex' identifier stays
+///  valid until the vertex is removed; afterwards, it may be reused for a new vertex.
+/// @n The same restrictions as for thor::triangulateConstrained() apply: no two vertices may have the same position, no vertex may lie
+///  on a constrained edge, and constrained edges must not intersect each other.
+class THOR_API DynamicTriangulation
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates an empty triangulation.
+									DynamicTriangulation();
+
+		/// @brief Inserts a vertex into the triangulation.
+		/// @details Only the triangles near the vertex are changed. The triangle containing the vertex is found by walking from the
+		///  previously edited vertex, so edits close to each other are fastest.
+		/// @return Identifier of the new vertex.
+		std::uint32_t				insertVertex(sf::Vector2f position);
+
+		/// @brief Removes a vertex from the triangulation.
+		/// @details Constrained edges at the vertex are removed as well.
+		/// @param vertex Identifier of a vertex in the triangulation.
+		void						removeVertex(std::uint32_t vertex);
+
+		/// @brief Moves a vertex to a new position.
+		/// @details Constrained edges at the vertex are kept. As long as the vertex stays inside the polygon formed by its neighbors,
+		///  it is moved in place; otherwise, it is removed and inserted again at the new position.
+		/// @param vertex Identifier of a vertex in the triangulation.
+		/// @param position New position of the vertex.
+		void						moveVertex(std::uint32_t vertex, sf::Vector2f position);
+
+		/// @brief Returns the position of a vertex.
+		/// @param vertex Identifier of a vertex in the triangulation.
+		sf::Vector2f				getVertexPosition(std::uint32_t vertex) const;
+
+		/// @brief Inserts a constrained edge, which is part of the triangulation until it is removed.
+		/// @param start,end Identifiers of two different vertices in the triangulation.
+		void						insertConstrainedEdge(std::uint32_t start, std::uint32_t end);
+
+		/// @brief Removes a constrained edge.
+		/// @details Afterwards, the edge may disappear from the triangulation to restore the Delaunay condition.
+		/// @param start,end Identifiers of the vertices of a constrained edge (in any order).
+		void						removeConstrainedEdge(std::uint32_t start, std::uint32_t end);
+
+		/// @brief Writes the current triangles as vertex identifiers.
+		/// @param indicesOut Output iterator to which three identifiers of type std::uint32_t are written per triangle. The corners of
+		///  each triangle are in clockwise order.
+		/// @return Iterator after the last written element.
+		template <typename OutputIterator>
+		OutputIterator				getTriangleIndices(OutputIterator indicesOut) const;
+
+		/// @brief Removes all vertices and constrained edges.
+		/// @details Allocated memory is kept for later use.
+		void						clear();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		detail::TriangulationData		mData;
+		std::vector<detail::TrIndex>	mFreeVertices;
+		detail::TrIndex					mLastVertex;
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Math/Detail/DynamicTriangulation.inl>
+#endif // THOR_DYNAMICTRIANGULATION_HPP
@@ -0,0 +1,118 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::StreamingTriangulation
+
+#ifndef THOR_STREAMINGTRIANGULATION_HPP
+#define THOR_STREAMINGTRIANGULATION_HPP
+
+#include <Thor/Math/Detail/TriangulationData.hpp>
+#include <Thor/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+
+namespace thor
+{
+
+/// @addtogroup Math
+/// @{
+
+/// @brief Delaunay triangulation of a vertex stream, which writes triangles as soon as they are final
+/// @details Computes a Delaunay triangulation like thor::triangulateIndexed(), but without keeping all vertices and triangles in
+///  memory. This is useful for large point clouds, such as terrain data.
+/// @n The region that contains the vertices is divided into a grid of cells. Vertices are inserted one after another, and the user
+///  finalizes a cell as soon as no more vertices will be inserted into it. A triangle whose circumcircle only touches finalized cells
+///  cannot be changed by later vertices; it is written to the output and freed. If the input is spatially sorted (for example, cell by
+///  cell, and each cell is finalized after its vertices), the memory usage is proportional to the front of cells that are not
+///  finalized, not to the whole input. Once every cell is finalized, all triangles have been written; finish() writes the rest
+///  if cells remain.
+/// @n Vertices are referred to by their index in the stream, i.e. the number of vertices inserted before. The same restrictions as
+///  for thor::triangulate() apply; in particular, no two vertices may have the same position.
+class THOR_API StreamingTriangulation
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Constructor
+		/// @param boundsMin,boundsMax Corners of the rectangle that contains all vertices of the stream.
+		/// @param columns,rows Number of cells in x and y direction, at least 1 each. With finer cells, triangles become final earlier.
+									StreamingTriangulation(sf::Vector2f boundsMin, sf::Vector2f boundsMax, unsigned int columns, unsigned int rows);
+
+		/// @brief Inserts the next vertex of the stream.
+		/// @details The triangle containing the vertex is found by walking from the previous vertex, so spatially sorted input is fastest.
+		/// @param position Position inside the bounds, in a cell that has not been finalized.
+		/// @return Index of the vertex in the stream.
+		std::uint32_t				insertVertex(sf::Vector2f position);
+
+		/// @brief Declares that no more vertices will be inserted into a cell, and writes the triangles that became final.
+		/// @param column,row Cell that has not been finalized yet.
+		/// @param indicesOut Output iterator to which three vertex indices of type std::uint32_t are written per final triangle. The
+		///  corners of each triangle are in clockwise order.
+		/// @return Iterator after the last written element.
+		template <typename OutputIterator>
+		OutputIterator				finalizeCell(unsigned int column, unsigned int row, OutputIterator indicesOut);
+
+		/// @brief Ends the stream and writes all remaining triangles.
+		/// @details Afterwards, a new stream with the same bounds and cells can be started; its vertex indices begin at 0 again.
+		/// @param indicesOut Output iterator to which three vertex indices are written per triangle, as in finalizeCell().
+		/// @return Iterator after the last written element.
+		template <typename OutputIterator>
+		OutputIterator				finish(OutputIterator indicesOut);
+
+		/// @brief Returns the cell that contains a position.
+		/// @return Column in x, row in y. Positions outside the bounds are assigned to the closest cell.
+		sf::Vector2u				getCell(sf::Vector2f position) const;
+
+		/// @brief Returns the number of triangles that are currently kept in memory.
+		/// @details This includes the triangles that are not final yet and helper triangles at the border of the bounds.
+		std::size_t					getActiveTriangleCount() const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Moves the buffered indices to the user's output
+		template <typename OutputIterator>
+		OutputIterator				flushOutput(OutputIterator indicesOut);
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		detail::StreamingTriangulationData	mData;
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Math/Detail/StreamingTriangulation.inl>
+#endif // THOR_STREAMINGTRIANGULATION_HPP
@@ -32,20 +32,17 @@
 #include <SFML/System/Vector2.hpp>
 
 #include <Thor/Math/TriangulationFigures.hpp>
+#include <Thor/Math/Detail/TriangulationData.hpp>
 
 #include <Aurora/Tools/ForEach.hpp>
-#include <Aurora/SmartPtr/CopiedPtr.hpp>
 
 #include <vector>
-#include <deque>
-#include <list>
-#include <set>
-#include <map>
+#include <algorithm>
+#include <functional>
 #include <iterator>
 #include <type_traits>
-#ifndef NDEBUG
- #include <typeinfo> // for detail::AdvancedVertex::getUserVertex<V>()
-#endif
+#include <utility>
+#include <cstdint>
 
 
 namespace thor
@@ -115,6 +112,171 @@ OutputIterator				triangulatePolygon(InputIterator verticesBegin, InputIterator
 template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
 OutputIterator1				triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut, OutputIterator2 edgesOut);
 
+/// @brief Marks a triangle edge without neighbor in the adjacency output of the indexed triangulation functions
+/// @details The edge lies on the border of the triangulation.
+const std::uint32_t			NoAdjacentTriangle = 0xffffffff;
+
+/// @brief Delaunay Triangulation with indexed output
+/// @details Computes the same triangulation as thor::triangulate(), but instead of thor::Triangle objects, it writes the triangles
+///  as a flat index buffer, which can be used directly for indexed meshes (e.g. in OpenGL).
+/// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long as
+///  thor::TriangulationTraits<V> is specialized.
+/// @param indicesOut Output iterator to which three values of type std::uint32_t are written per triangle. Each value is the offset of
+///  a triangle corner in the range [verticesBegin, verticesEnd[. The order of the triangles and their corners is the same as in thor::triangulate().
+/// @return Output iterator after the last index written.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator				triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut);
+
+/// @brief Delaunay Triangulation with indexed output and adjacency
+/// @details Like the overload without adjacency, but additionally writes three values of type std::uint32_t per triangle to @a adjacencyOut:
+///  Value i is the number of the triangle (in output order) on the other side of the edge between the corners i and (i+1) % 3,
+///  or thor::NoAdjacentTriangle if the edge lies on the border.
+/// @return Output iterator after the last index written to @a indicesOut.
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1				triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut);
+
+/// @brief Constrained Delaunay Triangulation with indexed output
+/// @details Computes the same triangulation as thor::triangulateConstrained(), but writes three std::uint32_t offsets into the range
+///  [verticesBegin, verticesEnd[ per triangle to @a indicesOut. See thor::triangulateIndexed() for the output format.
+/// @return Output iterator after the last index written.
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+OutputIterator				triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+								InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator indicesOut);
+
+/// @brief Constrained Delaunay Triangulation with indexed output and adjacency
+/// @details See thor::triangulateIndexed() for the format of @a indicesOut and @a adjacencyOut.
+/// @return Output iterator after the last index written to @a indicesOut.
+template <typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1				triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+								InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut);
+
+/// @brief Polygon Delaunay Triangulation with indexed output
+/// @details Computes the same triangulation as thor::triangulatePolygon(), but writes three std::uint32_t offsets into the range
+///  [verticesBegin, verticesEnd[ per triangle to @a indicesOut. See thor::triangulateIndexed() for the output format.
+/// @return Output iterator after the last index written.
+template <typename InputIterator, typename OutputIterator>
+OutputIterator				triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut);
+
+/// @brief Polygon Delaunay Triangulation with indexed output and adjacency
+/// @details See thor::triangulateIndexed() for the format of @a indicesOut and @a adjacencyOut. Edges on the polygon outline have no
+///  adjacent triangle.
+/// @return Output iterator after the last index written to @a indicesOut.
+template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+OutputIterator1				triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut);
+
+/// @brief Reusable workspace for triangulations
+/// @details Provides the same algorithms as the free functions thor::triangulate(), thor::triangulateConstrained() and
+///  thor::triangulatePolygon(), with identical results. In contrast to them, a Triangulator keeps the memory of its internal
+///  data structures between calls. If you triangulate repeatedly (e.g. a concave shape that is modified every frame), reuse the
+///  same Triangulator: as soon as its buffers are large enough for the input, further calls do not allocate any memory apart
+///  from what your output iterators allocate.
+/// @n A Triangulator is not thread-safe; use one object per thread to triangulate concurrently.
+class THOR_API Triangulator
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates a workspace without any memory reserved.
+									Triangulator();
+
+		/// @brief Delaunay Triangulation
+		/// @details Same as thor::triangulate(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator>
+		OutputIterator				triangulate(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut);
+
+		/// @brief Constrained Delaunay Triangulation
+		/// @details Same as thor::triangulateConstrained(); refer to its documentation for the parameters.
+		template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+		OutputIterator				triangulateConstrained(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+										InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator trianglesOut);
+
+		/// @brief Polygon Delaunay Triangulation
+		/// @details Same as thor::triangulatePolygon(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator>
+		OutputIterator				triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator trianglesOut);
+
+		/// @brief Polygon Delaunay Triangulation with edge output
+		/// @details Same as the corresponding overload of thor::triangulatePolygon(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+		OutputIterator1				triangulatePolygon(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 trianglesOut, OutputIterator2 edgesOut);
+
+		/// @brief Delaunay Triangulation with indexed output
+		/// @details Same as thor::triangulateIndexed(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator>
+		OutputIterator				triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut);
+
+		/// @brief Delaunay Triangulation with indexed output and adjacency
+		/// @details Same as thor::triangulateIndexed(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+		OutputIterator1				triangulateIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut);
+
+		/// @brief Constrained Delaunay Triangulation with indexed output
+		/// @details Same as thor::triangulateConstrainedIndexed(); refer to its documentation for the parameters.
+		template <typename InputIterator1, typename InputIterator2, typename OutputIterator>
+		OutputIterator				triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+										InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator indicesOut);
+
+		/// @brief Constrained Delaunay Triangulation with indexed output and adjacency
+		/// @details Same as thor::triangulateConstrainedIndexed(); refer to its documentation for the parameters.
+		template <typename InputIterator1, typename InputIterator2, typename OutputIterator1, typename OutputIterator2>
+		OutputIterator1				triangulateConstrainedIndexed(InputIterator1 verticesBegin, InputIterator1 verticesEnd,
+										InputIterator2 constrainedEdgesBegin, InputIterator2 constrainedEdgesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut);
+
+		/// @brief Polygon Delaunay Triangulation with indexed output
+		/// @details Same as thor::triangulatePolygonIndexed(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator>
+		OutputIterator				triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator indicesOut);
+
+		/// @brief Polygon Delaunay Triangulation with indexed output and adjacency
+		/// @details Same as thor::triangulatePolygonIndexed(); refer to its documentation for the parameters.
+		template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+		OutputIterator1				triangulatePolygonIndexed(InputIterator verticesBegin, InputIterator verticesEnd, OutputIterator1 indicesOut, OutputIterator2 adjacencyOut);
+
+		/// @brief Triangulates many polygons, distributed over several threads
+		/// @details Computes the same triangles as calling thor::triangulatePolygon() for each polygon, but concurrently on the threads
+		///  specified by setThreadCount(). Each thread keeps its own scratch memory inside the Triangulator. The results are written
+		///  in polygon order after all polygons have been triangulated.
+		/// @param polygonsBegin,polygonsEnd Iterator range to the polygons. Each polygon is a range of vertices that can be passed to
+		///  std::begin() and std::end() (such as std::vector<sf::Vector2f>); see thor::triangulatePolygon() for the requirements on
+		///  the vertices. The polygons must stay at their addresses until the function returns.
+		/// @param trianglesOut Output iterator to which the triangles of all polygons are written, polygon by polygon. The element
+		///  type is thor::Triangle<V>, where V is the vertex type of the polygons.
+		/// @param triangleCountsOut Output iterator to which the number of triangles of each polygon is written as std::uint32_t.
+		///  Polygon i's triangles follow the triangles of polygon i-1 in @a trianglesOut.
+		/// @return Output iterator after the last triangle written to @a trianglesOut.
+		template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+		OutputIterator1				triangulatePolygons(InputIterator polygonsBegin, InputIterator polygonsEnd, OutputIterator1 trianglesOut, OutputIterator2 triangleCountsOut);
+
+		/// @brief Triangulates many polygons with indexed output, distributed over several threads
+		/// @details Like triangulatePolygons(), but writes three std::uint32_t offsets into the polygon's vertex range per triangle
+		///  to @a indicesOut, as thor::triangulatePolygonIndexed() does.
+		/// @return Output iterator after the last index written to @a indicesOut.
+		template <typename InputIterator, typename OutputIterator1, typename OutputIterator2>
+		OutputIterator1				triangulatePolygonsIndexed(InputIterator polygonsBegin, InputIterator polygonsEnd, OutputIterator1 indicesOut, OutputIterator2 triangleCountsOut);
+
+		/// @brief Sets the number of threads used by triangulate(), triangulateIndexed() and the batch functions for polygons.
+		/// @details With more than one thread, large point sets are split into vertical strips that are triangulated concurrently and
+		///  merged afterwards. The result consists of the same triangles as with a single thread, possibly in a different order. Only where
+		///  rounding errors let the algorithm deviate from the exact Delaunay triangulation (at nearly co-circular or collinear points), the
+		///  results may differ locally. Small point sets are always triangulated by the calling thread alone. triangulatePolygons() and
+		///  triangulatePolygonsIndexed() distribute whole polygons over the threads. The other triangulations are not affected by this setting.
+		/// @param threadCount Number of threads, including the calling one. 0 means as many threads as the hardware supports. By default, 1.
+		void						setThreadCount(unsigned int threadCount);
+
+		/// @brief Releases the memory held by the internal buffers.
+		/// @details Useful after an exceptionally large triangulation, if the Triangulator is kept for later smaller inputs.
+		void						releaseMemory();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		detail::TriangulationData			mData;
+		detail::ParallelTriangulationData	mParallel;
+		detail::BatchTriangulationData		mBatch;
+};
+
 /// @}
 
 } // namespace thor
@@ -0,0 +1,148 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::TriangulationQuery
+
+#ifndef THOR_TRIANGULATIONQUERY_HPP
+#define THOR_TRIANGULATIONQUERY_HPP
+
+#include <Thor/Math/Triangulation.hpp>
+#include <Thor/Math/Detail/TriangulationData.hpp>
+#include <Thor/Vectors/VectorAlgebra2D.hpp>
+#include <Thor/Config.hpp>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <cassert>
+#include <cstdint>
+
+
+namespace thor
+{
+
+/// @addtogroup Math
+/// @{
+
+/// @brief Value returned by TriangulationQuery::locateTriangle() for points outside the triangulation
+const std::uint32_t NoTriangle = 0xffffffff;
+
+/// @brief Edge of a Voronoi diagram
+/// @details Separates the Voronoi cells of two vertices, which are connected by an edge in the Delaunay triangulation.
+struct VoronoiEdge
+{
+	std::uint32_t				vertices[2];	///< Input indices of the two vertices whose cells are separated by the edge
+	sf::Vector2f				start;			///< First endpoint, the circumcenter of a triangle
+	sf::Vector2f				end;			///< Second endpoint, or unit direction of the edge if it is infinite
+	bool						infinite;		///< True if the edge is a ray, which begins at start and extends in direction end
+};
+
+/// @brief Delaunay triangulation that answers spatial queries
+/// @details Triangulates a set of points like thor::triangulateIndexed(), and keeps the result to find the triangle that contains a
+///  point or the vertex nearest to it. Both queries walk through the triangulation and take expected constant time for roughly
+///  uniformly distributed vertices. In addition, the Voronoi diagram (the dual of the Delaunay triangulation) can be extracted.
+/// @n Vertices are referred to by their index in the input range, triangles by indices in [0, getTriangleCount()[.
+/// @n The vertex positions are copied, so the input range need not be kept alive.
+class THOR_API TriangulationQuery
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates a query object without vertices.
+									TriangulationQuery();
+
+		/// @brief Constructor
+		/// @details Equivalent to default construction followed by triangulate().
+		template <typename InputIterator>
+									TriangulationQuery(InputIterator verticesBegin, InputIterator verticesEnd);
+
+		/// @brief Triangulates a new set of points, replacing the previous one.
+		/// @param verticesBegin,verticesEnd Iterator range to the points being triangulated. The element type V can be any type as long
+		///  as thor::TriangulationTraits<V> is specialized. No two points may have the same position.
+		template <typename InputIterator>
+		void						triangulate(InputIterator verticesBegin, InputIterator verticesEnd);
+
+		/// @brief Returns the number of triangles.
+		std::uint32_t				getTriangleCount() const;
+
+		/// @brief Returns a corner of a triangle.
+		/// @details The corners of each triangle are in clockwise order.
+		/// @param triangle Index of the triangle.
+		/// @param corner Number of the corner, 0, 1 or 2.
+		/// @return Input index of the vertex at the corner.
+		std::uint32_t				getTriangleCorner(std::uint32_t triangle, unsigned int corner) const;
+
+		/// @brief Returns the triangle adjacent to an edge.
+		/// @param triangle Index of the triangle.
+		/// @param edge Number of the edge, which connects the corners @a edge and (@a edge+1) % 3.
+		/// @return Index of the neighbor triangle, or thor::NoAdjacentTriangle at the border of the triangulation.
+		std::uint32_t				getAdjacentTriangle(std::uint32_t triangle, unsigned int edge) const;
+
+		/// @brief Finds the triangle that contains a point.
+		/// @param point The point to locate.
+		/// @param hint Index of a triangle at which the search begins. If the point is close to a recent query, passing that result
+		///  shortens the search. By default, the search begins at a triangle near the point.
+		/// @return Index of the triangle, or thor::NoTriangle if the point is outside the triangulation.
+		std::uint32_t				locateTriangle(sf::Vector2f point, std::uint32_t hint = NoTriangle) const;
+
+		/// @brief Finds the vertex that is nearest to a point.
+		/// @return Input index of the nearest vertex. There must be at least one vertex.
+		std::uint32_t				findNearestVertex(sf::Vector2f point) const;
+
+		/// @brief Returns the center of a triangle's circumcircle.
+		/// @details The circumcenters are the vertices of the Voronoi diagram.
+		sf::Vector2f				getCircumcenter(std::uint32_t triangle) const;
+
+		/// @brief Computes the edges of the Voronoi diagram.
+		/// @details The Voronoi cell of a vertex is the region of points that are closer to this vertex than to any other one.
+		///  Cells of vertices at the border of the triangulation are unbounded; their outer edges are rays.
+		/// @param edgesOut Output iterator to which elements of type thor::VoronoiEdge are written.
+		/// @return Iterator after the last written element.
+		template <typename OutputIterator>
+		OutputIterator				getVoronoiEdges(OutputIterator edgesOut) const;
+
+		/// @brief Computes the corners of a vertex' Voronoi cell.
+		/// @details The corners are written in clockwise order. If the cell is unbounded (the vertex is at the border of the
+		///  triangulation), only its finite corners are written; the first and the last one are the start points of the rays.
+		/// @param vertex Input index of the vertex.
+		/// @param cornersOut Output iterator to which elements of type sf::Vector2f are written.
+		/// @return Iterator after the last written element.
+		template <typename OutputIterator>
+		OutputIterator				getVoronoiCell(std::uint32_t vertex, OutputIterator cornersOut) const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		detail::TriangulationQueryData	mData;
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Math/Detail/TriangulationQuery.inl>
+#endif // THOR_TRIANGULATIONQUERY_HPP
@@ -30,10 +30,16 @@
 #define THOR_MODULE_RESOURCES_HPP
 
 #include <Thor/Resources/OwnershipModels.hpp>
+#include <Thor/Resources/StorageModels.hpp>
 #include <Thor/Resources/KnownIdStrategy.hpp>
+#include <Thor/Resources/ResourceHandle.hpp>
 #include <Thor/Resources/ResourceHolder.hpp>
+#include <Thor/Resources/ConcurrentResourceHolder.hpp>
+#include <Thor/Resources/ResourceBatch.hpp>
 #include <Thor/Resources/ResourceLoader.hpp>
 #include <Thor/Resources/ResourceExceptions.hpp>
+#include <Thor/Resources/ResourcePack.hpp>
+#include <Thor/Resources/ImageCache.hpp>
 #include <Thor/Resources/SfmlLoaders.hpp>
 
 #endif // THOR_MODULE_RESOURCES_HPP
@@ -0,0 +1,182 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class template thor::ConcurrentResourceHolder
+
+#ifndef THOR_CONCURRENTRESOURCEHOLDER_HPP
+#define THOR_CONCURRENTRESOURCEHOLDER_HPP
+
+#include <Thor/Resources/ResourceHolder.hpp>
+#include <Thor/Resources/KnownIdStrategy.hpp>
+#include <Thor/Resources/OwnershipModels.hpp>
+#include <Thor/Resources/ResourceExceptions.hpp>
+#include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/StorageModels.hpp>
+
+#include <Aurora/Tools/NonCopyable.hpp>
+#include <Aurora/Tools/ForEach.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+
+
+namespace thor
+{
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Resource holder that can be accessed from multiple threads.
+/// @details Provides the same acquisition and access semantics as ResourceHolder, but all member functions may be called from
+///  any thread. It is meant for resources that are read by many threads, while being acquired or released only occasionally.
+/// @n@n Accessing resources does not lock the holder: every acquisition and release publishes an immutable snapshot of the
+///  stored resources, in which the accessing threads look up IDs. Publishing takes time linear in the number of resources.
+///  Acquisitions and releases are serialized by a mutex, which is not held while a resource is loaded.
+/// @n@n With the RefCounted ownership policy, the last shared_ptr to a resource may be destroyed on any thread. With the
+///  CentralOwner policy, a resource must not be released while other threads use it. The Cached policy is not supported.
+/// @tparam R Type of resources managed, for example sf::Texture.
+/// @tparam I Type of the ID, to identify resources.
+/// @tparam O Ownership model, see ResourceHolder.
+/// @tparam S Storage model, see ResourceHolder.
+template <typename R, typename I, class O = Resources::CentralOwner, class S = Resources::OrderedStorage>
+class ConcurrentResourceHolder : private aurora::NonCopyable
+{
+	static_assert(!std::is_same<O, Resources::Cached>::value, "ConcurrentResourceHolder does not support the Cached ownership policy");
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private types
+	private:
+		typedef ResourceHolder<R, I, O, S>		Holder;
+		typedef typename Holder::Om				Om;
+		typedef typename Holder::Sm				Sm;
+
+		// Storage of the snapshots, which map IDs to the resources they refer to
+		typedef detail::StorageModel<S, I, typename Om::Handled>	Ss;
+		typedef typename Ss::Map				Snapshot;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public types
+	public:
+		/// @brief Resource handle for mutable access, see ResourceHolder::Resource.
+		/// @hideinitializer
+		typedef typename Holder::Resource		Resource;
+
+		/// @brief Resource handle for read-only access, see ResourceHolder::ConstResource.
+		/// @hideinitializer
+		typedef typename Holder::ConstResource	ConstResource;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		///
+									ConcurrentResourceHolder();
+
+		/// @brief Destructor
+		/// @details Releases the resources. With the RefCounted ownership policy, resources still referenced by shared_ptr objects
+		///  remain valid until the last one is destroyed, on whichever thread.
+									~ConcurrentResourceHolder();
+
+		/// @brief Searches for an occurrence of @a id and returns the mapped resource, if possible.
+		/// @details Behaves like ResourceHolder::acquire(). The resource is loaded without blocking other threads. If another thread
+		///  acquires the same ID in the meantime, @a known determines which resource is kept.
+		/// @param id Value identifying the resource.
+		/// @param how Resource loader containing loading information. Determines how the resource is loaded.
+		/// @param known Determines what happens if @a id is already stored, see ResourceHolder::acquire().
+		/// @return Handle to the resource.
+		/// @throw ResourceLoadingException if the loading of the resource fails.
+		/// @throw ResourceAccessException if @a known is AssumeNew and @a id is already stored.
+		Resource					acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known = Resources::AssumeNew);
+
+		/// @brief Releases a resource.
+		/// @details Behaves like ResourceHolder::release().
+		/// @param id Value that identifies the resource to release.
+		/// @throw ResourceAccessException if no resource with @a id is stored.
+		void						release(const I& id);
+
+		/// @brief Enables or disables sharing of resources acquired from the same source under different IDs.
+		/// @details See ResourceHolder::setDeduplication(). Only available with the RefCounted ownership policy.
+		void						setDeduplication(bool enabled);
+
+		/// @brief Accesses a resource.
+		/// @details Looks up the resource without locking the holder.
+		/// @param id Value that identifies the resource to access.
+		/// @return Handle to that resource.
+		/// @throw ResourceAccessException if no resource with @a id is stored, or if it has been released by another thread.
+		Resource					operator[] (const I& id);
+
+		/// @brief Accesses a resource (const overload).
+		/// @details Looks up the resource without locking the holder.
+		/// @param id Value that identifies the resource to access.
+		/// @return Handle to that resource, which does not allow modification of the resource.
+		/// @throw ResourceAccessException if no resource with @a id is stored, or if it has been released by another thread.
+		ConstResource				operator[] (const I& id) const;
+
+		/// @brief Accesses a resource using a key other than the ID type.
+		/// @details See ResourceHolder::operator[](const K&). Looks up the resource without locking the holder.
+		/// @throw ResourceAccessException if no resource with @a key is stored, or if it has been released by another thread.
+		template <typename K>
+		Resource					operator[] (const K& key);
+
+		/// @brief Accesses a resource using a key other than the ID type (const overload).
+		/// @details See ResourceHolder::operator[](const K&). Looks up the resource without locking the holder.
+		/// @throw ResourceAccessException if no resource with @a key is stored, or if it has been released by another thread.
+		template <typename K>
+		ConstResource				operator[] (const K& key) const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Looks up a resource in the current snapshot
+		template <typename K>
+		Resource					find(const K& key) const;
+
+		// Finds the element of id, after erasing it if its resource has been released by another thread (mutex must be locked)
+		typename Sm::Map::iterator	findStored(const I& id);
+
+		// Makes the stored resources visible to accessing threads (mutex must be locked)
+		void						publish();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		Holder								mHolder;
+		std::shared_ptr<std::recursive_mutex>	mMutex;			// Shared with the deleters of the RefCounted policy
+		std::shared_ptr<const Snapshot>		mSnapshot;		// Accessed only through std::atomic_load() and std::atomic_store()
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Resources/Detail/ConcurrentResourceHolder.inl>
+#endif // THOR_CONCURRENTRESOURCEHOLDER_HPP
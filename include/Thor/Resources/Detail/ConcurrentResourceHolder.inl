@@ -0,0 +1,218 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+
+template <typename R, typename I, class O, class S>
+ConcurrentResourceHolder<R, I, O, S>::ConcurrentResourceHolder()
+: mHolder()
+, mMutex(std::make_shared<std::recursive_mutex>())
+, mSnapshot(std::make_shared<Snapshot>())
+{
+	Om::setMutex(mHolder.mContext, mMutex);
+}
+
+template <typename R, typename I, class O, class S>
+ConcurrentResourceHolder<R, I, O, S>::~ConcurrentResourceHolder()
+{
+	// Deleters on other threads may erase elements at the same time
+	std::lock_guard<std::recursive_mutex> lock(*mMutex);
+	mHolder.mMap.clear();
+}
+
+template <typename R, typename I, class O, class S>
+typename ConcurrentResourceHolder<R, I, O, S>::Resource ConcurrentResourceHolder<R, I, O, S>::acquire(const I& id, const ResourceLoader<R>& how,
+	Resources::KnownIdStrategy known)
+{
+	{
+		std::lock_guard<std::recursive_mutex> lock(*mMutex);
+
+		// ID is known: behavior depends on strategy
+		auto found = findStored(id);
+		if (found != mHolder.mMap.end())
+		{
+			switch (known)
+			{
+				default:
+				case Resources::AssumeNew:
+					throw ResourceAccessException("Failed to load resource, ID already stored in ResourceHolder");
+
+				case Resources::Reload:
+					break;
+
+				case Resources::Reuse:
+					try
+					{
+						return Om::makeReturned(Om::makeHandled(found->second.stored));
+					}
+					catch (ResourceAccessException&)
+					{
+						// Last shared_ptr has been destroyed on another thread since findStored(): load the resource anew
+						mHolder.erase(found);
+					}
+					break;
+			}
+		}
+
+		// Resource from the same source is loaded under another ID: share it
+		else if (std::shared_ptr<R> shared = Om::findLoaded(mHolder.mContext, how))
+		{
+			Resource returned = mHolder.store(id, nullptr, std::move(shared), how);
+			publish();
+			return returned;
+		}
+	}
+
+	// Load without holding the lock, so that other threads can acquire, and release their shared_ptrs meanwhile
+	std::unique_ptr<R> original = how.load();
+	if (!original)
+		throw ResourceLoadingException("Failed to load resource \"" + how.getInfo() + "\"");
+
+	std::lock_guard<std::recursive_mutex> lock(*mMutex);
+
+	// ID may have been acquired by another thread in the meantime
+	auto found = findStored(id);
+	if (found != mHolder.mMap.end())
+	{
+		switch (known)
+		{
+			default:
+			case Resources::AssumeNew:
+				throw ResourceAccessException("Failed to load resource, ID already stored in ResourceHolder");
+
+			case Resources::Reload:
+				mHolder.erase(found);
+				break;
+
+			case Resources::Reuse:
+				try
+				{
+					return Om::makeReturned(Om::makeHandled(found->second.stored));
+				}
+				catch (ResourceAccessException&)
+				{
+					mHolder.erase(found);
+				}
+				break;
+		}
+	}
+
+	Resource returned = mHolder.store(id, std::move(original), nullptr, how);
+	publish();
+	return returned;
+}
+
+template <typename R, typename I, class O, class S>
+void ConcurrentResourceHolder<R, I, O, S>::release(const I& id)
+{
+	std::lock_guard<std::recursive_mutex> lock(*mMutex);
+
+	auto found = findStored(id);
+	if (found == mHolder.mMap.end())
+		throw ResourceAccessException("Failed to release resource, ID not currently stored in ResourceHolder");
+
+	mHolder.erase(found);
+	publish();
+}
+
+template <typename R, typename I, class O, class S>
+void ConcurrentResourceHolder<R, I, O, S>::setDeduplication(bool enabled)
+{
+	std::lock_guard<std::recursive_mutex> lock(*mMutex);
+	mHolder.setDeduplication(enabled);
+}
+
+template <typename R, typename I, class O, class S>
+typename ConcurrentResourceHolder<R, I, O, S>::Resource ConcurrentResourceHolder<R, I, O, S>::operator[] (const I& id)
+{
+	return find(id);
+}
+
+template <typename R, typename I, class O, class S>
+typename ConcurrentResourceHolder<R, I, O, S>::ConstResource ConcurrentResourceHolder<R, I, O, S>::operator[] (const I& id) const
+{
+	return find(id);
+}
+
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ConcurrentResourceHolder<R, I, O, S>::Resource ConcurrentResourceHolder<R, I, O, S>::operator[] (const K& key)
+{
+	return find(key);
+}
+
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ConcurrentResourceHolder<R, I, O, S>::ConstResource ConcurrentResourceHolder<R, I, O, S>::operator[] (const K& key) const
+{
+	return find(key);
+}
+
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ConcurrentResourceHolder<R, I, O, S>::Resource ConcurrentResourceHolder<R, I, O, S>::find(const K& key) const
+{
+	// The snapshot stays alive while it is used, even if a newer one is published meanwhile
+	std::shared_ptr<const Snapshot> snapshot = std::atomic_load(&mSnapshot);
+
+	auto found = Ss::find(*snapshot, key);
+	if (found == snapshot->end() || Om::isExpired(found->second))
+		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
+
+	return Om::makeReturned(found->second);
+}
+
+template <typename R, typename I, class O, class S>
+typename ConcurrentResourceHolder<R, I, O, S>::Sm::Map::iterator ConcurrentResourceHolder<R, I, O, S>::findStored(const I& id)
+{
+	auto found = Sm::find(mHolder.mMap, id);
+
+	// The last shared_ptr has been destroyed, but its deleter waits for the mutex: erase the element here, so the deleter skips it
+	if (found != mHolder.mMap.end() && Om::isExpired(Om::makeHandled(found->second.stored)))
+	{
+		mHolder.erase(found);
+		return mHolder.mMap.end();
+	}
+
+	return found;
+}
+
+template <typename R, typename I, class O, class S>
+void ConcurrentResourceHolder<R, I, O, S>::publish()
+{
+	auto snapshot = std::make_shared<Snapshot>();
+
+	AURORA_FOREACH(const typename Sm::Map::value_type& element, mHolder.mMap)
+	{
+		typename Om::Handled handled = Om::makeHandled(element.second.stored);
+		if (!Om::isExpired(handled))
+			snapshot->insert(std::make_pair(element.first, handled));
+	}
+
+	std::atomic_store(&mSnapshot, std::shared_ptr<const Snapshot>(std::move(snapshot)));
+}
+
+} // namespace thor
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_FILEACCESS_HPP
+#define THOR_FILEACCESS_HPP
+
+#include <Thor/Config.hpp>
+
+#include <string>
+#include <cstdint>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Maps a whole file read-only into memory. Returns nullptr on failure, also for empty files.
+	const char*			THOR_API mapFile(const std::string& filename, std::size_t& size);
+
+	// Unmaps a file mapped by mapFile()
+	void				THOR_API unmapFile(const char* mapping, std::size_t size);
+
+	// Determines size and modification time (in seconds) of a file. Returns false if the file cannot be accessed.
+	bool				THOR_API getFileStatus(const std::string& filename, std::uint64_t& size, std::int64_t& modificationTime);
+
+	// Reads an unsigned integer stored in little endian byte order
+	template <typename T>
+	T readLittleEndian(const char* bytes)
+	{
+		T value = 0;
+		for (std::size_t i = 0; i < sizeof(T); ++i)
+			value |= static_cast<T>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+
+		return value;
+	}
+
+	// Appends an unsigned integer in little endian byte order
+	template <typename T>
+	void writeLittleEndian(std::string& out, T value)
+	{
+		for (std::size_t i = 0; i < sizeof(T); ++i)
+			out += static_cast<char>((value >> (8 * i)) & 0xff);
+	}
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_FILEACCESS_HPP
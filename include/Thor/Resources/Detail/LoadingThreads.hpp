@@ -0,0 +1,161 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#ifndef THOR_LOADINGTHREADS_HPP
+#define THOR_LOADINGTHREADS_HPP
+
+#include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Config.hpp>
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Work item for the loading threads
+	struct LoadingTask
+	{
+		LoadingTask(std::function<void()> run, int priority)
+		: run(std::move(run))
+		, priority(priority)
+		, sequence(0)
+		, claimed(false)
+		{
+		}
+
+		std::function<void()>		run;			// Function to execute in the background
+		int							priority;		// Tasks with higher priority are run first
+		std::uint64_t				sequence;		// Among equal priorities, tasks are run in the order they were pushed
+		std::atomic<bool>			claimed;		// Set by the thread that runs the task, or when the task is no longer needed
+	};
+
+	// Pool of threads that run loading tasks in the order of their priority
+	class THOR_API LoadingThreads : private aurora::NonCopyable
+	{
+		public:
+			// Starts threadCount threads (0 means as many as the hardware supports)
+			explicit					LoadingThreads(unsigned int threadCount);
+
+			// Waits until the tasks being run are finished; tasks that have not begun are discarded
+										~LoadingThreads();
+
+			// Enqueues a task. It is skipped if claimed before a thread picks it up.
+			void						push(std::shared_ptr<LoadingTask> task);
+
+		private:
+			void						work();
+
+		private:
+			std::vector<std::shared_ptr<LoadingTask>>	mQueue;			// Binary heap, task with highest priority in front
+			std::vector<std::thread>	mThreads;
+			std::mutex					mMutex;
+			std::condition_variable		mCondition;
+			std::uint64_t				mSequence;
+			bool						mStopped;
+	};
+
+	// Asynchronous acquisition of a resource in ResourceHolder
+	template <typename R, typename I, typename Resource>
+	struct PendingAcquisition
+	{
+		PendingAcquisition(const I& id, const ResourceLoader<R>& loader)
+		: id(id)
+		, loader(loader)
+		, finisher()
+		, error()
+		, promise()
+		, future(promise.get_future().share())
+		, task()
+		, prepared(false)
+		{
+		}
+
+		I								id;				// ID under which the resource will be stored
+		ResourceLoader<R>				loader;
+		typename ResourceLoader<R>::Loader	finisher;	// Result of the background phase, completes the resource on the owning thread
+		std::exception_ptr				error;			// Exception thrown by the background phase, reported through the promise
+		std::promise<Resource>			promise;
+		std::shared_future<Resource>	future;
+		std::shared_ptr<LoadingTask>	task;
+		bool							prepared;		// True when finisher is set (protected by the mutex in LoadingState)
+	};
+
+	// State shared by a ResourceHolder and the loading threads
+	template <typename Pending>
+	struct LoadingState
+	{
+		std::mutex								mutex;
+		std::condition_variable					condition;		// Notified when an acquisition is prepared
+		std::vector<std::shared_ptr<Pending>>	prepared;		// Acquisitions waiting to be finalized on the owning thread, in order
+	};
+
+	// Runs the background phase of an acquisition and hands it to the owning thread. The task refers weakly to the state and the
+	// acquisition, which refer to the task; the acquisition may have been cancelled and the ResourceHolder destroyed meanwhile.
+	template <typename Pending>
+	void prepareAcquisition(const std::weak_ptr<LoadingState<Pending>>& weakState, const std::weak_ptr<Pending>& weakPending)
+	{
+		std::shared_ptr<LoadingState<Pending>> state = weakState.lock();
+		std::shared_ptr<Pending> pending = weakPending.lock();
+		if (!state || !pending)
+			return;
+
+		// Exceptions must not escape the loading thread; they are passed to the owning thread, which fulfills the promise
+		decltype(pending->finisher) finisher;
+		std::exception_ptr error;
+		try
+		{
+			finisher = pending->loader.prepare();
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+		pending->finisher = std::move(finisher);
+		pending->error = error;
+		pending->prepared = true;
+		state->prepared.push_back(std::move(pending));
+		state->condition.notify_all();
+	}
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_LOADINGTHREADS_HPP
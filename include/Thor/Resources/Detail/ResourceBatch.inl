@@ -0,0 +1,196 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+namespace thor
+{
+namespace detail
+{
+
+	// Keeps resources of shared ownership policies alive after the commit
+	template <typename R>
+	void keepCommitted(std::vector<std::shared_ptr<void>>& committed, const std::shared_ptr<R>& resource)
+	{
+		committed.push_back(resource);
+	}
+
+	template <typename R>
+	void keepCommitted(std::vector<std::shared_ptr<void>>&, R&)
+	{
+	}
+
+	template <typename R, typename I>
+	class BatchItemImpl : public BatchItem
+	{
+		public:
+			BatchItemImpl(const I& id, const ResourceLoader<R>& loader, Resources::KnownIdStrategy known)
+			: id(id)
+			, loader(loader)
+			, known(known)
+			, finisher()
+			, resource()
+			{
+			}
+
+			virtual void prepare()
+			{
+				finisher = loader.prepare();
+			}
+
+			virtual bool finish()
+			{
+				if (finisher)
+					resource = finisher();
+
+				finisher = nullptr;
+				return resource != nullptr;
+			}
+
+			virtual void discard()
+			{
+				finisher = nullptr;
+				resource.reset();
+			}
+
+			virtual std::string getInfo() const
+			{
+				return loader.getInfo();
+			}
+
+		public:
+			I							id;
+			ResourceLoader<R>			loader;
+			Resources::KnownIdStrategy	known;
+			typename ResourceLoader<R>::Loader	finisher;
+			std::unique_ptr<R>			resource;
+	};
+
+	template <typename R, typename I, class O, class S>
+	class BatchGroupImpl : public BatchGroup
+	{
+		public:
+			typedef ResourceHolder<R, I, O, S>	Holder;
+			typedef BatchItemImpl<R, I>			Item;
+
+			explicit BatchGroupImpl(Holder& holder)
+			: holder(&holder)
+			, items()
+			, ids()
+			, committed()
+			{
+			}
+
+			virtual const void* getHolder() const
+			{
+				return holder;
+			}
+
+			virtual void validate() const
+			{
+				AURORA_FOREACH(const std::shared_ptr<Item>& item, items)
+				{
+					if (item->known == Resources::AssumeNew && isKnown(item->id))
+						throw ResourceAccessException("Failed to load resource, ID already stored in ResourceHolder");
+				}
+			}
+
+			virtual void commit()
+			{
+				AURORA_FOREACH(const std::shared_ptr<Item>& item, items)
+				{
+					if (isKnown(item->id))
+					{
+						if (item->known == Resources::Reuse)
+						{
+							item->resource.reset();
+							continue;
+						}
+
+						// Reload: replace the known resource (AssumeNew has been rejected by validate())
+						holder->cancelAcquisition(item->id);
+
+						auto found = Holder::Sm::find(holder->mMap, item->id);
+						if (found != holder->mMap.end())
+							holder->erase(found);
+					}
+
+					keepCommitted(committed, holder->store(item->id, std::move(item->resource), nullptr, item->loader));
+				}
+			}
+
+			// Adds an item; throws if the ID is already in this group
+			std::shared_ptr<Item> add(const I& id, const ResourceLoader<R>& loader, Resources::KnownIdStrategy known)
+			{
+				if (Ids::find(ids, id) != ids.end())
+					throw ResourceAccessException("Failed to add resource, ID already in ResourceBatch");
+
+				Ids::insert(ids, id);
+				items.push_back(std::make_shared<Item>(id, loader, known));
+				return items.back();
+			}
+
+		private:
+			typedef StorageModel<S, I, char>	Ids;
+
+			bool isKnown(const I& id) const
+			{
+				return Holder::Sm::find(holder->mMap, id) != holder->mMap.end() || holder->isAcquiring(id);
+			}
+
+		private:
+			Holder*								holder;
+			std::vector<std::shared_ptr<Item>>	items;
+			typename Ids::Map					ids;
+			std::vector<std::shared_ptr<void>>	committed;
+	};
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+template <typename R, typename I, class O, class S>
+void ResourceBatch::add(ResourceHolder<R, I, O, S>& holder, const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known)
+{
+	typedef detail::BatchGroupImpl<R, I, O, S> Group;
+	assert(!mStarted);
+
+	// Find group of the holder, or create it
+	Group* group = nullptr;
+	AURORA_FOREACH(const std::unique_ptr<detail::BatchGroup>& existing, mGroups)
+	{
+		if (existing->getHolder() == &holder)
+			group = static_cast<Group*>(existing.get());
+	}
+
+	if (!group)
+	{
+		mGroups.push_back(aurora::makeUnique<Group>(holder));
+		group = static_cast<Group*>(mGroups.back().get());
+	}
+
+	mItems.push_back(group->add(id, how, known));
+}
+
+} // namespace thor
@@ -26,33 +26,82 @@
 namespace thor
 {
 
-template <typename R, typename I, class O>
-ResourceHolder<R, I, O>::ResourceHolder()
+template <typename R, typename I, class O, class S>
+ResourceHolder<R, I, O, S>::ResourceHolder()
 : mMap()
+, mContext(Om::makeContext())
+, mSlots()
+, mFreeSlots()
+, mSlotSweepSize(16)
+, mPending()
+, mState(std::make_shared<State>())
+, mLoadingThreadCount(1)
+, mLoadingThreads()
 {
 }
 
-template <typename R, typename I, class O>
-ResourceHolder<R, I, O>::ResourceHolder(ResourceHolder&& source)
+template <typename R, typename I, class O, class S>
+ResourceHolder<R, I, O, S>::ResourceHolder(ResourceHolder&& source)
 : mMap(std::move(source.mMap))
+, mContext(std::move(source.mContext))
+, mSlots(std::move(source.mSlots))
+, mFreeSlots(std::move(source.mFreeSlots))
+, mSlotSweepSize(source.mSlotSweepSize)
+, mPending(std::move(source.mPending))
+, mState(std::move(source.mState))
+, mLoadingThreadCount(source.mLoadingThreadCount)
+, mLoadingThreads(std::move(source.mLoadingThreads))
 {
+	source.mContext = Om::makeContext();
+	source.mSlots.clear();
+	source.mFreeSlots.clear();
+	source.mState = std::make_shared<State>();
 }
 
-template <typename R, typename I, class O>
-ResourceHolder<R, I, O>& ResourceHolder<R, I, O>::operator= (ResourceHolder&& source)
+template <typename R, typename I, class O, class S>
+ResourceHolder<R, I, O, S>& ResourceHolder<R, I, O, S>::operator= (ResourceHolder&& source)
 {
+	// Stop own loading threads before their state is replaced
+	mLoadingThreads = std::move(source.mLoadingThreads);
 	mMap = std::move(source.mMap);
+	mContext = std::move(source.mContext);
+	mSlots = std::move(source.mSlots);
+	mFreeSlots = std::move(source.mFreeSlots);
+	mSlotSweepSize = source.mSlotSweepSize;
+	mPending = std::move(source.mPending);
+	mState = std::move(source.mState);
+	mLoadingThreadCount = source.mLoadingThreadCount;
 
+	source.mContext = Om::makeContext();
+	source.mSlots.clear();
+	source.mFreeSlots.clear();
+	source.mState = std::make_shared<State>();
 	return *this;
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known)
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known)
 {
+	// ID is being acquired asynchronously: Reload discards that acquisition instead of loading twice, otherwise complete it first
+	bool isReloaded = false;
+	auto pending = Pm::find(mPending, id);
+	if (pending != mPending.end())
+	{
+		if (known == Resources::Reload)
+		{
+			cancelAcquisition(id);
+			isReloaded = true;
+		}
+		else
+		{
+			finalizeNow(pending);
+		}
+	}
+
 	// ID is new: we always load the resource
-	auto found = mMap.find(id);
+	auto found = Sm::find(mMap, id);
 	if (found == mMap.end())
-		return load(id, how);
+		return load(id, how, !isReloaded);
 
 	// ID is known: behavior depends on strategy
 	switch (known)
@@ -63,71 +112,445 @@ typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::acquire(cons
 
 		case Resources::Reload:
 			release(id);
-			return load(id, how);
+			return load(id, how, false);
 
 		case Resources::Reuse:
-			return Om::makeReturned(found->second);
+			return Om::makeReturned(found->second.stored);
 	}
 }
 
-template <typename R, typename I, class O>
-void ResourceHolder<R, I, O>::release(const I& id)
+template <typename R, typename I, class O, class S>
+std::shared_future<typename ResourceHolder<R, I, O, S>::Resource> ResourceHolder<R, I, O, S>::acquireAsync(const I& id, const ResourceLoader<R>& how,
+	Resources::KnownIdStrategy known, int priority)
+{
+	auto pending = Pm::find(mPending, id);
+	auto found = Sm::find(mMap, id);
+
+	// ID is known: behavior depends on strategy
+	const bool isKnown = pending != mPending.end() || found != mMap.end();
+	if (isKnown)
+	{
+		switch (known)
+		{
+			default:
+			case Resources::AssumeNew:
+				throw ResourceAccessException("Failed to load resource, ID already stored in ResourceHolder");
+
+			case Resources::Reload:
+				cancelAcquisition(id);
+				break;
+
+			case Resources::Reuse:
+			{
+				if (pending != mPending.end())
+					return pending->second->future;
+
+				std::promise<Resource> promise;
+				promise.set_value(Om::makeReturned(found->second.stored));
+				return promise.get_future().share();
+			}
+		}
+	}
+
+	// Resource from the same source is loaded under another ID: share it right away
+	else if (std::shared_ptr<R> shared = Om::findLoaded(mContext, how))
+	{
+		std::promise<Resource> promise;
+		promise.set_value(store(id, nullptr, std::move(shared), how));
+		return promise.get_future().share();
+	}
+
+	if (!mLoadingThreads)
+		mLoadingThreads = aurora::makeUnique<detail::LoadingThreads>(mLoadingThreadCount);
+
+	auto acquisition = std::make_shared<Pending>(id, how);
+	std::weak_ptr<State> weakState = mState;
+	std::weak_ptr<Pending> weakAcquisition = acquisition;
+
+	acquisition->task = std::make_shared<detail::LoadingTask>(
+		[weakState, weakAcquisition] () { detail::prepareAcquisition(weakState, weakAcquisition); },
+		priority);
+
+	mLoadingThreads->push(acquisition->task);
+	Pm::insert(mPending, id)->second = acquisition;
+
+	return acquisition->future;
+}
+
+template <typename R, typename I, class O, class S>
+std::size_t ResourceHolder<R, I, O, S>::finalizeAcquisitions(std::size_t maxCount)
+{
+	std::size_t count = 0;
+	while (count < maxCount)
+	{
+		std::shared_ptr<Pending> acquisition;
+
+		{
+			std::lock_guard<std::mutex> lock(mState->mutex);
+			if (mState->prepared.empty())
+				break;
+
+			acquisition = std::move(mState->prepared.front());
+			mState->prepared.erase(mState->prepared.begin());
+		}
+
+		// Skip acquisitions that have been cancelled or completed by acquire() in the meantime
+		auto pending = Pm::find(mPending, acquisition->id);
+		if (pending == mPending.end() || pending->second != acquisition)
+			continue;
+
+		mPending.erase(pending);
+		finalize(std::move(acquisition));
+		++count;
+	}
+
+	return count;
+}
+
+template <typename R, typename I, class O, class S>
+bool ResourceHolder<R, I, O, S>::cancelAcquisition(const I& id)
+{
+	auto pending = Pm::find(mPending, id);
+	if (pending == mPending.end())
+		return false;
+
+	// Prevent the task from being started; if it is running, its result is skipped by finalizeAcquisitions()
+	std::shared_ptr<Pending> acquisition = std::move(pending->second);
+	acquisition->task->claimed = true;
+	mPending.erase(pending);
+
+	acquisition->promise.set_exception(std::make_exception_ptr(
+		ResourceLoadingException("Failed to load resource \"" + acquisition->loader.getInfo() + "\", acquisition cancelled")));
+
+	return true;
+}
+
+template <typename R, typename I, class O, class S>
+bool ResourceHolder<R, I, O, S>::isAcquiring(const I& id) const
 {
-	auto found = mMap.find(id);
+	return Pm::find(mPending, id) != mPending.end();
+}
+
+template <typename R, typename I, class O, class S>
+std::size_t ResourceHolder<R, I, O, S>::getAcquisitionCount() const
+{
+	return mPending.size();
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::setDeduplication(bool enabled)
+{
+	static_assert(std::is_same<O, Resources::RefCounted>::value, "setDeduplication() requires the RefCounted ownership policy");
+
+	mContext.deduplicate = enabled;
+	if (!enabled)
+		mContext.loads.clear();
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::setCacheBudget(std::size_t budget)
+{
+	static_assert(std::is_same<O, Resources::Cached>::value, "setCacheBudget() requires the Cached ownership policy");
+
+	mContext->budget = budget;
+	mContext->trim();
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::setCacheMeasure(std::function<std::size_t(const R&)> measure)
+{
+	static_assert(std::is_same<O, Resources::Cached>::value, "setCacheMeasure() requires the Cached ownership policy");
+
+	// Resources already in the cache keep their size
+	mContext->measure = std::move(measure);
+}
+
+template <typename R, typename I, class O, class S>
+std::size_t ResourceHolder<R, I, O, S>::getCacheSize() const
+{
+	static_assert(std::is_same<O, Resources::Cached>::value, "getCacheSize() requires the Cached ownership policy");
+
+	return mContext->unusedSize;
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::setLoadingThreadCount(unsigned int threadCount)
+{
+	assert(mPending.empty());
+
+	mLoadingThreads.reset();
+	mLoadingThreadCount = threadCount;
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::release(const I& id)
+{
+	auto found = Sm::find(mMap, id);
 	if (found == mMap.end())
 		throw ResourceAccessException("Failed to release resource, ID not currently stored in ResourceHolder");
 
-	mMap.erase(found);
+	erase(found);
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::operator[] (const I& id)
+template <typename R, typename I, class O, class S>
+ResourceHandle ResourceHolder<R, I, O, S>::getHandle(const I& id) const
 {
-	auto found = mMap.find(id);
+	auto found = Sm::find(mMap, id);
 	if (found == mMap.end())
 		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
 
-	return Om::makeReturned(found->second);
+	const std::uint32_t index = found->second.slot;
+	return ResourceHandle(index, mSlots[index].generation);
+}
+
+template <typename R, typename I, class O, class S>
+bool ResourceHolder<R, I, O, S>::isValid(ResourceHandle handle) const
+{
+	return findSlot(handle) != nullptr;
+}
+
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::operator[] (ResourceHandle handle)
+{
+	const Slot* slot = findSlot(handle);
+	if (!slot)
+		throw ResourceAccessException("Failed to access resource, handle refers to a released resource");
+
+	return Om::makeReturned(slot->handled);
+}
+
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::ConstResource ResourceHolder<R, I, O, S>::operator[] (ResourceHandle handle) const
+{
+	const Slot* slot = findSlot(handle);
+	if (!slot)
+		throw ResourceAccessException("Failed to access resource, handle refers to a released resource");
+
+	return Om::makeReturned(slot->handled);
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::ConstResource ResourceHolder<R, I, O>::operator[] (const I& id) const
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::operator[] (const I& id)
 {
-	auto found = mMap.find(id);
+	auto found = Sm::find(mMap, id);
 	if (found == mMap.end())
 		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
 
-	return Om::makeReturned(found->second);
+	return Om::makeReturned(found->second.stored);
 }
 
-template <typename R, typename I, class O>
-typename ResourceHolder<R, I, O>::Resource ResourceHolder<R, I, O>::load(const I& id, const ResourceLoader<R>& what)
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::ConstResource ResourceHolder<R, I, O, S>::operator[] (const I& id) const
 {
-	assert(mMap.find(id) == mMap.end());
+	auto found = Sm::find(mMap, id);
+	if (found == mMap.end())
+		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
+
+	return Om::makeReturned(found->second.stored);
+}
+
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::operator[] (const K& key)
+{
+	auto found = Sm::find(mMap, key);
+	if (found == mMap.end())
+		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
+
+	return Om::makeReturned(found->second.stored);
+}
+
+template <typename R, typename I, class O, class S>
+template <typename K>
+typename ResourceHolder<R, I, O, S>::ConstResource ResourceHolder<R, I, O, S>::operator[] (const K& key) const
+{
+	auto found = Sm::find(mMap, key);
+	if (found == mMap.end())
+		throw ResourceAccessException("Failed to access resource, ID not currently stored in ResourceHolder");
+
+	return Om::makeReturned(found->second.stored);
+}
+
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::load(const I& id, const ResourceLoader<R>& what, bool shareLoaded)
+{
+	assert(Sm::find(mMap, id) == mMap.end());
 
 	// Loading process is rather complicated because it has to respect different ownership semantics.
 	// That's why the resource is moved several times. The data flow is as follows:
 	// original (temporary) ----> loaded (temporary) .---> returned (handed out to user)
 	//                                                `--> stored (stored in resource holder's map)
-	std::unique_ptr<R> original = what.load();
-	if (!original)
-		throw ResourceLoadingException("Failed to load resource \"" + what.getInfo() + "\"");
+	// If the ownership policy can share a resource loaded from the same source, original remains empty
+	std::shared_ptr<R> shared;
+	if (shareLoaded)
+		shared = Om::findLoaded(mContext, what);
+
+	std::unique_ptr<R> original;
+	if (!shared)
+	{
+		original = what.load();
+		if (!original)
+			throw ResourceLoadingException("Failed to load resource \"" + what.getInfo() + "\"");
+	}
+
+	return store(id, std::move(original), std::move(shared), what);
+}
+
+template <typename R, typename I, class O, class S>
+typename ResourceHolder<R, I, O, S>::Resource ResourceHolder<R, I, O, S>::store(const I& id, std::unique_ptr<R> original, std::shared_ptr<R> shared,
+	const ResourceLoader<R>& how)
+{
+	assert(Sm::find(mMap, id) == mMap.end());
 
 	// Insert initially empty element, to learn about its iterator
-	auto inserted = mMap.insert(std::make_pair(id, typename Om::Stored())).first;
+	auto inserted = Sm::insert(mMap, id);
 
 	// For ownership policies that try to be smart and remove resources from the holder when unused,
 	// we need to pass them information about the container and the iterator referring to the element
 	auto elementRef = detail::makeElementRef(mMap, inserted);
 
 	// Create temporary 'loaded' object and from it, 'returned' object given to user
-	typename Om::Loaded loaded = Om::makeLoaded(std::move(original), std::move(elementRef));
+	typename Om::Loaded loaded = Om::makeLoaded(std::move(original), std::move(shared), std::move(elementRef), how, mContext);
 	typename Om::Returned returned = Om::makeReturned(loaded);
 
 	// Actually store resource (together with tracking element) in map
-	inserted->second = Om::makeStored(std::move(loaded));
+	inserted->second.stored = Om::makeStored(std::move(loaded));
+	inserted->second.slot = allocateSlot(inserted->second.stored);
 
 	return returned;
 }
 
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::erase(typename Sm::Map::iterator itr)
+{
+	freeSlot(itr->second.slot);
+	mMap.erase(itr);
+}
+
+template <typename R, typename I, class O, class S>
+std::uint32_t ResourceHolder<R, I, O, S>::allocateSlot(const typename Om::Stored& stored)
+{
+	// Ownership policies that erase unused resources themselves leave slots behind; reclaim them once the storage has grown
+	if (mFreeSlots.empty() && mSlots.size() >= mSlotSweepSize)
+	{
+		std::size_t usedCount = 0;
+		for (std::uint32_t index = 0; index < mSlots.size(); ++index)
+		{
+			if (!mSlots[index].used)
+				continue;
+
+			if (Om::isExpired(mSlots[index].handled))
+				freeSlot(index);
+			else
+				++usedCount;
+		}
+
+		mSlotSweepSize = std::max<std::size_t>(16, 2 * usedCount);
+	}
+
+	std::uint32_t index;
+	if (mFreeSlots.empty())
+	{
+		index = static_cast<std::uint32_t>(mSlots.size());
+		mSlots.push_back(Slot());
+		mSlots.back().generation = 1;
+	}
+	else
+	{
+		index = mFreeSlots.back();
+		mFreeSlots.pop_back();
+	}
+
+	Slot& slot = mSlots[index];
+	slot.handled = Om::makeHandled(stored);
+	slot.used = true;
+	return index;
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::freeSlot(std::uint32_t index)
+{
+	// Generation 0 is reserved for default-constructed handles
+	Slot& slot = mSlots[index];
+	if (++slot.generation == 0)
+		slot.generation = 1;
+
+	slot.handled = typename Om::Handled();
+	slot.used = false;
+	mFreeSlots.push_back(index);
+}
+
+template <typename R, typename I, class O, class S>
+const typename ResourceHolder<R, I, O, S>::Slot* ResourceHolder<R, I, O, S>::findSlot(ResourceHandle handle) const
+{
+	if (handle.mIndex >= mSlots.size())
+		return nullptr;
+
+	const Slot& slot = mSlots[handle.mIndex];
+	if (!slot.used || slot.generation != handle.mGeneration || Om::isExpired(slot.handled))
+		return nullptr;
+
+	return &slot;
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::finalize(std::shared_ptr<Pending> acquisition)
+{
+	if (acquisition->error)
+	{
+		acquisition->finisher = nullptr;
+		acquisition->promise.set_exception(acquisition->error);
+		return;
+	}
+
+	std::unique_ptr<R> original;
+	if (acquisition->finisher)
+		original = acquisition->finisher();
+
+	// Release data of the background part on this thread
+	acquisition->finisher = nullptr;
+
+	if (!original)
+	{
+		acquisition->promise.set_exception(std::make_exception_ptr(
+			ResourceLoadingException("Failed to load resource \"" + acquisition->loader.getInfo() + "\"")));
+		return;
+	}
+
+	// Acquisitions with the Reload strategy replace the stored resource
+	auto found = Sm::find(mMap, acquisition->id);
+	if (found != mMap.end())
+		erase(found);
+
+	acquisition->promise.set_value(store(acquisition->id, std::move(original), nullptr, acquisition->loader));
+}
+
+template <typename R, typename I, class O, class S>
+void ResourceHolder<R, I, O, S>::finalizeNow(typename PendingMap::iterator pendingItr)
+{
+	std::shared_ptr<Pending> acquisition = std::move(pendingItr->second);
+	mPending.erase(pendingItr);
+
+	// If no loading thread has begun the background part, run it here; otherwise wait until it is finished
+	if (!acquisition->task->claimed.exchange(true))
+	{
+		try
+		{
+			acquisition->finisher = acquisition->loader.prepare();
+		}
+		catch (...)
+		{
+			acquisition->error = std::current_exception();
+		}
+	}
+	else
+	{
+		std::unique_lock<std::mutex> lock(mState->mutex);
+		while (!acquisition->prepared)
+			mState->condition.wait(lock);
+	}
+
+	finalize(std::move(acquisition));
+}
+
 } // namespace thor
@@ -27,6 +27,7 @@
 #define THOR_RESOURCELOADERHELPERS_HPP
 
 #include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/ImageCache.hpp>
 #include <Thor/Graphics/ToString.hpp>
 #include <Thor/Config.hpp>
 
@@ -36,7 +37,8 @@
 #include <functional>
 #include <memory>
 #include <sstream>
-#include <cstring>
+#include <string>
+#include <cstdio>
 #include <type_traits>
 
 
@@ -45,68 +47,152 @@ namespace sf
 
 	class InputStream;
 	class Image;
+	class Texture;
+	class Font;
+	class SoundBuffer;
 
 } // namespace sf
 
 
 namespace thor
 {
+
+class ImageAtlas;
+
 namespace detail
 {
 
+	// Appends the textual representation of a value to a key string
+	inline void appendToKey(std::string& key, const std::string& value)
+	{
+		key += value;
+	}
+
+	inline void appendToKey(std::string& key, const char* value)
+	{
+		key += value;
+	}
+
+	inline void appendToKey(std::string& key, const sf::Color& color)
+	{
+		key += toString(color);
+	}
+
+	inline void appendToKey(std::string& key, const sf::IntRect& rect)
+	{
+		key += toString(rect);
+	}
+
+	inline void appendToKey(std::string& key, const void* pointer)
+	{
+		char buffer[32];
+		std::snprintf(buffer, sizeof(buffer), "%p", pointer);
+		key += buffer;
+	}
+
+	template <typename T>
+	void appendToKey(std::string& key, const T& value, std::integral_constant<int, 0>) // other types
+	{
+		std::ostringstream stream;
+		stream << value;
+		key += stream.str();
+	}
+
+	template <typename T>
+	void appendToKey(std::string& key, const T& value, std::integral_constant<int, 1>) // arithmetic types
+	{
+		key += std::to_string(value);
+	}
+
+	template <typename T>
+	void appendToKey(std::string& key, const T& value, std::integral_constant<int, 2>) // enums
+	{
+		key += std::to_string(static_cast<typename std::underlying_type<T>::type>(value));
+	}
+
+	template <typename T>
+	void appendToKey(std::string& key, const T& value, std::integral_constant<int, 3>) // pointers
+	{
+		appendToKey(key, static_cast<const void*>(value));
+	}
+
+	template <typename T>
+	void appendToKey(std::string& key, const T& value)
+	{
+		// Numbers and pointers are formatted directly, only other types need a string stream
+		appendToKey(key, value, std::integral_constant<int,
+			std::is_arithmetic<T>::value ? 1 :
+			std::is_enum<T>::value ? 2 :
+			std::is_pointer<T>::value ? 3 : 0>());
+	}
+
 	// Helper class to build unique string tags from several properties
 	struct Tagger
 	{
 		Tagger(const char* text = "")
-		: stream()
+		: key()
 		, begin(true)
 		{
-			if (std::strlen(text) != 0)
-				stream << "[From" << text << "] ";
+			key.reserve(64);
+			if (*text != '\0')
+			{
+				key += "[From";
+				key += text;
+				key += "] ";
+			}
 		}
 
-		// Enable If to exclude sf::InputStream derivates
 		template <typename T>
 		Tagger& operator<< (const T& value)
 		{
 			// Insert separator before every value except the first
 			if (!begin)
-				stream << "; ";
+				key += "; ";
 			begin = false;
 
 			// Push actual value
-			stream << value;
+			appendToKey(key, value);
 			return *this;
 		}
 
-		Tagger& operator<< (const sf::Color& color)
-		{
-			return operator<< (toString(color));
-		}
-
-		Tagger& operator<< (const sf::IntRect& rect)
-		{
-			return operator<< (toString(rect));
-		}
-
 		operator std::string() const
 		{
-			// Remove last separator
-			std::string s = stream.str();
-			if (!s.empty() && s.rfind("; ") == s.size() - 2)
-				s.erase(s.size() - 2);
-			return s;
+			return key;
 		}
 
-		std::ostringstream	stream;
+		std::string			key;
 		bool				begin;
 	};
 
+	// Determines whether a resource can be loaded completely on a background thread. Resources that need an OpenGL context, such as
+	// sf::Texture or sf::Shader, are loaded on the thread owning the ResourceHolder.
+	template <class R>
+	struct IsBackgroundLoadable : std::false_type {};
+
+	template <>
+	struct IsBackgroundLoadable<sf::Image> : std::true_type {};
+
+	template <>
+	struct IsBackgroundLoadable<sf::Font> : std::true_type {};
+
+	template <>
+	struct IsBackgroundLoadable<sf::SoundBuffer> : std::true_type {};
+
+	template <>
+	struct IsBackgroundLoadable<ImageAtlas> : std::true_type {};
+
+	// Image type to which textures are decoded. Depends on R, so that sf::Image is only required when a texture loader is instantiated.
+	template <class R>
+	struct DecodedImage
+	{
+		typedef sf::Image Type;
+	};
+
 	// Creates a resource loader by transforming the function
 	//      bool               boolLoader(R&)
 	// to:  std::unique_ptr<R> loader()
 	template <class R, typename Fn>
-	ResourceLoader<R> makeResourceLoader(Fn boolLoader, std::string key)
+	ResourceLoader<R> makeResourceLoader(Fn boolLoader, std::string key, std::false_type)
 	{
 		auto loader = [=] () -> std::unique_ptr<R>
 		{
@@ -117,7 +203,124 @@ namespace detail
 				return nullptr;
 		};
 
-		return ResourceLoader<R>(loader, key);
+		return ResourceLoader<R>(typename ResourceLoader<R>::Loader(loader), key);
+	}
+
+	// Same as above, but the loading happens in the first phase, so it can run on a background thread
+	template <class R, typename Fn>
+	ResourceLoader<R> makeResourceLoader(Fn boolLoader, std::string key, std::true_type)
+	{
+		auto preparer = [=] () -> typename ResourceLoader<R>::Loader
+		{
+			// Loader must be copyable, so the resource is kept in a shared_ptr, from which the second phase moves it out
+			auto resource = std::make_shared<std::unique_ptr<R>>(new R());
+			if (!boolLoader(**resource))
+				return nullptr;
+
+			return [=] () { return std::move(*resource); };
+		};
+
+		return ResourceLoader<R>(typename ResourceLoader<R>::Preparer(preparer), key);
+	}
+
+	template <class R, typename Fn>
+	ResourceLoader<R> makeResourceLoader(Fn boolLoader, std::string key)
+	{
+		return makeResourceLoader<R>(boolLoader, std::move(key), IsBackgroundLoadable<R>());
+	}
+
+	// Source from which a texture loader decodes the image in the first phase
+	struct FileSource
+	{
+		template <class Image>
+		bool operator() (Image& image) const
+		{
+			return image.loadFromFile(filename);
+		}
+
+		std::string filename;
+	};
+
+	struct MemorySource
+	{
+		template <class Image>
+		bool operator() (Image& image) const
+		{
+			return data != nullptr && image.loadFromMemory(data, size);
+		}
+
+		const void* data;
+		std::size_t size;
+	};
+
+	struct CachedFileSource
+	{
+		template <class Image>
+		bool operator() (Image& image) const
+		{
+			return cache->loadImage(image, filename);
+		}
+
+		const ImageCache* cache;
+		std::string filename;
+	};
+
+	// Loads a resource from the image that source provides: images directly, other resources through loadFromImage()
+	template <class R, typename Source>
+	bool loadFromImageSource(R& image, const Source& source, std::true_type)
+	{
+		return source(image);
+	}
+
+	template <class R, typename Source>
+	bool loadFromImageSource(R& resource, const Source& source, std::false_type)
+	{
+		typename DecodedImage<R>::Type image;
+		return source(image) && resource.loadFromImage(image);
+	}
+
+	template <class R, typename Source>
+	bool loadFromImageSource(R& resource, const Source& source)
+	{
+		return loadFromImageSource(resource, source, std::is_same<R, typename DecodedImage<R>::Type>());
+	}
+
+	// Creates a loader for R::loadFromFile(filename, area) or R::loadFromMemory(data, size, area). Textures are decoded from the
+	// source to an image in the first phase, and only uploaded to the graphics card in the second one.
+	template <class R, typename Fn, typename Source, typename Area>
+	ResourceLoader<R> makeDecodingLoader(Fn, const Source& source, const Area& area, std::string key, std::true_type)
+	{
+		typedef typename DecodedImage<R>::Type Image;
+
+		auto preparer = [=] () -> typename ResourceLoader<R>::Loader
+		{
+			auto image = std::make_shared<Image>();
+			if (!source(*image))
+				return nullptr;
+
+			return [=] () -> std::unique_ptr<R>
+			{
+				std::unique_ptr<R> resource(new R());
+				if (resource->loadFromImage(*image, area))
+					return resource;
+				else
+					return nullptr;
+			};
+		};
+
+		return ResourceLoader<R>(typename ResourceLoader<R>::Preparer(preparer), key);
+	}
+
+	template <class R, typename Fn, typename Source, typename Area>
+	ResourceLoader<R> makeDecodingLoader(Fn boolLoader, const Source&, const Area&, std::string key, std::false_type)
+	{
+		return makeResourceLoader<R>(boolLoader, std::move(key));
+	}
+
+	template <class R, typename Fn, typename Source, typename Area>
+	ResourceLoader<R> makeDecodingLoader(Fn boolLoader, const Source& source, const Area& area, std::string key)
+	{
+		return makeDecodingLoader<R>(boolLoader, source, area, std::move(key), std::is_same<R, sf::Texture>());
 	}
 
 } // namespace detail
@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::ImageCache
+
+#ifndef THOR_IMAGECACHE_HPP
+#define THOR_IMAGECACHE_HPP
+
+#include <Thor/Config.hpp>
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <atomic>
+#include <string>
+
+
+namespace sf
+{
+
+	class Image;
+
+} // namespace sf
+
+
+namespace thor
+{
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Disk cache of decoded images.
+/// @details Decoding compressed image files such as PNG is expensive. The first time an image file is loaded through the cache,
+///  its decoded pixels are written to a cache file. Later loads map the cache file into memory and create the image directly
+///  from the pixels. A cache file is only used while the size and modification time of the image file are unchanged.
+/// @n@n Use Resources::fromCachedFile() to load images, textures or big textures through the cache. The cache files store
+///  uncompressed RGBA pixels, so they are larger than the image files.
+class THOR_API ImageCache : private aurora::NonCopyable
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Constructor
+		/// @param directory Existing directory in which the cache files are stored.
+		explicit					ImageCache(const std::string& directory);
+
+		/// @brief Loads an image, from the cache if possible.
+		/// @details If the cache has no up-to-date entry for @a filename, the file is decoded and the cache file is written.
+		///  This function may be called from multiple threads concurrently.
+		/// @param image Image to load.
+		/// @param filename Name of the image file.
+		/// @return True if the image has been loaded, false otherwise.
+		bool						loadImage(sf::Image& image, const std::string& filename) const;
+
+		/// @brief Returns the name of the cache file for an image file.
+		///
+		std::string					getCacheFilename(const std::string& filename) const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		std::string					mDirectory;
+		mutable std::atomic<unsigned int>	mWriteCount;
+};
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_IMAGECACHE_HPP
@@ -29,12 +29,23 @@
 #ifndef THOR_OWNERSHIPMODELS_HPP
 #define THOR_OWNERSHIPMODELS_HPP
 
+#include <Thor/Resources/ResourceExceptions.hpp>
+#include <Thor/Resources/ResourceLoader.hpp>
 #include <Thor/Config.hpp>
 
 #include <Aurora/Meta/Templates.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <cassert>
+#include <cstdint>
 
 
 namespace thor
@@ -60,9 +71,20 @@ namespace Resources
 	///  Access to resources is granted through reference-counted shared pointers. One resource can be used by multiple shared_ptr
 	///  objects; the last one being destroyed releases the resource. You @b must store a shared_ptr upon loading the resource, or
 	///  it will be released immediately.
+	/// @n@n If deduplication is enabled (see ResourceHolder::setDeduplication()), resources acquired from the same source under
+	///  different IDs are loaded only once and shared.
 	/// @n@n With this policy, the user accesses resources through <b>std::shared_ptr<R></b> or <b>std::shared_ptr<const R></b>.
 	struct RefCounted {};
 
+	/// @brief Cache ownership policy
+	/// @details Like with RefCounted, resources are accessed through shared pointers. However, when the last shared_ptr to a resource
+	///  is destroyed, the resource is not released, but kept in a cache, so that accessing it again is cheap. When the resources in
+	///  the cache exceed the memory budget (see ResourceHolder::setCacheBudget()), the least recently used ones are released.
+	/// @n@n A released resource remains known to the ResourceHolder: accessing its ID reloads it, using the ResourceLoader that was
+	///  passed to ResourceHolder::acquire(). Only ResourceHolder::release() forgets the resource.
+	/// @n@n With this policy, the user accesses resources through <b>std::shared_ptr<R></b> or <b>std::shared_ptr<const R></b>.
+	struct Cached {};
+
 } // namespace Resources
 
 /// @}
@@ -73,13 +95,36 @@ namespace Resources
 namespace detail
 {
 
+	// Refers to an element in std::map, whose iterators remain valid
 	template <typename Map>
 	struct ElementRef
 	{
+		void erase()
+		{
+			// Verify resource ID is still there
+			assert(map->find(itr->first) != map->end());
+			map->erase(itr);
+		}
+
 		Map* map;
 		typename Map::iterator itr;
 	};
 
+	// Refers to an element in std::unordered_map. Rehashing invalidates iterators, but not references to elements.
+	template <typename K, typename V, typename H, typename E, typename A>
+	struct ElementRef<std::unordered_map<K, V, H, E, A>>
+	{
+		void erase()
+		{
+			auto itr = map->find(*key);
+			assert(itr != map->end());
+			map->erase(itr);
+		}
+
+		std::unordered_map<K, V, H, E, A>* map;
+		const K* key;
+	};
+
 	template <typename Map>
 	ElementRef<Map> makeElementRef(Map& map, typename Map::iterator itr)
 	{
@@ -88,17 +133,30 @@ namespace detail
 		return ref;
 	}
 
+	template <typename K, typename V, typename H, typename E, typename A>
+	ElementRef<std::unordered_map<K, V, H, E, A>> makeElementRef(std::unordered_map<K, V, H, E, A>& map,
+		typename std::unordered_map<K, V, H, E, A>::iterator itr)
+	{
+		ElementRef<std::unordered_map<K, V, H, E, A>> ref = {&map, &itr->first};
+		return ref;
+	}
+
+	// Locks the mutex of a ResourceHolder that is shared between threads, if any
+	inline std::unique_lock<std::recursive_mutex> lockShared(const std::shared_ptr<std::recursive_mutex>& mutex)
+	{
+		return mutex ? std::unique_lock<std::recursive_mutex>(*mutex) : std::unique_lock<std::recursive_mutex>();
+	}
+
 	template <typename R, typename Map>
 	struct TrackingDeleter
 	{
 		void operator() (R* pointer)
 		{
 			// If map element exists, erase it
-			if (!tracker.expired())
 			{
-				// Verify resource ID is still there
-				assert(element.map->find(element.itr->first) != element.map->end());
-				element.map->erase(element.itr);
+				auto lock = lockShared(mutex);
+				if (!tracker.expired())
+					element.erase();
 			}
 
 			// Perform actual deallocation
@@ -108,6 +166,147 @@ namespace detail
 
 		ElementRef<Map> element;
 		std::weak_ptr<char> tracker;
+		std::shared_ptr<std::recursive_mutex> mutex;
+	};
+
+	// Deleter for shared_ptr to a resource that is shared with another ID. The last one erases the own element from the map,
+	// while the resource itself is kept alive by shared, until the other ID's tracking deleter is invoked.
+	template <typename R, typename Map>
+	struct SharingDeleter
+	{
+		void operator() (R*)
+		{
+			{
+				auto lock = lockShared(mutex);
+				if (!tracker.expired())
+					element.erase();
+			}
+
+			shared.reset();
+		}
+
+		ElementRef<Map> element;
+		std::weak_ptr<char> tracker;
+		std::shared_ptr<std::recursive_mutex> mutex;
+		std::shared_ptr<R> shared;
+	};
+
+	// Estimates the memory used by a resource: 4 bytes per pixel for images and textures, 2 bytes per sample for sound buffers
+	template <typename R>
+	auto estimateMemorySizeImpl(const R& resource, int) -> decltype(resource.getSize().x, std::size_t())
+	{
+		return static_cast<std::size_t>(resource.getSize().x) * resource.getSize().y * 4;
+	}
+
+	template <typename R>
+	auto estimateMemorySizeImpl(const R& resource, long) -> decltype(resource.getSampleCount(), std::size_t())
+	{
+		return static_cast<std::size_t>(resource.getSampleCount()) * sizeof(std::int16_t);
+	}
+
+	template <typename R>
+	std::size_t estimateMemorySizeImpl(const R&, ...)
+	{
+		return sizeof(R);
+	}
+
+	template <typename R>
+	std::size_t estimateMemorySize(const R& resource)
+	{
+		return estimateMemorySizeImpl(resource, 0);
+	}
+
+	template <typename R>
+	struct CacheEntry;
+
+	// Resources of a ResourceHolder that are not referenced by the user, but kept in memory
+	template <typename R>
+	struct CacheState
+	{
+		CacheState()
+		: unused()
+		, unusedSize(0)
+		, budget(std::numeric_limits<std::size_t>::max())
+		, measure(&estimateMemorySize<R>)
+		{
+		}
+
+		// Releases the least recently used resources until the budget is met
+		void trim();
+
+		std::list<CacheEntry<R>*>				unused;			// Most recently used in front
+		std::size_t								unusedSize;		// Memory of the resources in unused
+		std::size_t								budget;
+		std::function<std::size_t(const R&)>	measure;
+	};
+
+	// Per ID: loader, and the resource while it is referenced by the user or in the cache
+	template <typename R>
+	struct CacheEntry
+	{
+		CacheEntry(const ResourceLoader<R>& loader, std::shared_ptr<CacheState<R>> cache)
+		: loader(loader)
+		, cache(std::move(cache))
+		, used()
+		, resident()
+		, size(0)
+		, position()
+		{
+		}
+
+		~CacheEntry()
+		{
+			if (resident)
+				unlink();
+		}
+
+		// Called when the user releases the resource
+		void keep(std::unique_ptr<R> resource)
+		{
+			resident = std::move(resource);
+			size = cache->measure(*resident);
+			position = cache->unused.insert(cache->unused.begin(), this);
+			cache->unusedSize += size;
+			cache->trim();
+		}
+
+		// Removes the resource from the cache (resident must be set)
+		std::unique_ptr<R> unlink()
+		{
+			cache->unused.erase(position);
+			cache->unusedSize -= size;
+			return std::move(resident);
+		}
+
+		ResourceLoader<R>						loader;
+		std::shared_ptr<CacheState<R>>			cache;
+		std::weak_ptr<R>						used;			// Resource while referenced by the user
+		std::unique_ptr<R>						resident;		// Resource while in the cache
+		std::size_t								size;			// Memory of resident
+		typename std::list<CacheEntry*>::iterator	position;		// Position in cache->unused, if resident
+	};
+
+	template <typename R>
+	void CacheState<R>::trim()
+	{
+		while (unusedSize > budget)
+			unused.back()->unlink();
+	}
+
+	// Deleter for shared_ptr, which gives the resource back to the cache instead of deleting it
+	template <typename R>
+	struct CacheDeleter
+	{
+		void operator() (R* pointer)
+		{
+			std::unique_ptr<R> resource(pointer);
+
+			// If the resource has not been released from the ResourceHolder, keep it
+			if (std::shared_ptr<CacheEntry<R>> locked = entry.lock())
+				locked->keep(std::move(resource));
+		}
+
+		std::weak_ptr<CacheEntry<R>> entry;
 	};
 
 	// Class to dispatch between ownership model, using partial template specialization
@@ -122,6 +321,24 @@ namespace detail
 		typedef const R&			ConstReturned;
 		typedef std::unique_ptr<R>	Loaded;
 		typedef std::unique_ptr<R>	Stored;
+		typedef R*					Handled;
+		struct						Context {};
+
+		static Context makeContext()
+		{
+			return Context();
+		}
+
+		// Resources are only released by the ResourceHolder, so there is nothing to synchronize
+		static void setMutex(Context&, std::shared_ptr<std::recursive_mutex>)
+		{
+		}
+
+		// Resources are never shared between IDs
+		static std::shared_ptr<R> findLoaded(const Context&, const ResourceLoader<R>&)
+		{
+			return nullptr;
+		}
 
 		static Returned makeReturned(const std::unique_ptr<R>& initialOrStorage)
 		{
@@ -129,7 +346,8 @@ namespace detail
 		}
 
 		template <typename Map>
-		static std::unique_ptr<R> makeLoaded(std::unique_ptr<R>&& resource, ElementRef<Map>&&)
+		static std::unique_ptr<R> makeLoaded(std::unique_ptr<R>&& resource, std::shared_ptr<R>&&, ElementRef<Map>&&, const ResourceLoader<R>&,
+			Context&)
 		{
 			return std::move(resource);
 		}
@@ -138,6 +356,22 @@ namespace detail
 		{
 			return std::move(loaded);
 		}
+
+		// Handled: what handles refer to (the stored resource is only released by the ResourceHolder)
+		static R* makeHandled(const std::unique_ptr<R>& stored)
+		{
+			return stored.get();
+		}
+
+		static bool isExpired(R*)
+		{
+			return false;
+		}
+
+		static Returned makeReturned(R* handled)
+		{
+			return *handled;
+		}
 	};
 
 	// Specialization for reference-counted ownership
@@ -163,6 +397,30 @@ namespace detail
 			std::weak_ptr<R> resource;
 		};
 
+		// Resources by hash of their loader's identifier, to share resources loaded from the same source (if deduplicate is set).
+		// The mutex, if set, is locked by the deleters before they erase elements (see ConcurrentResourceHolder).
+		struct Context
+		{
+			std::unordered_multimap<std::size_t, std::pair<std::string, std::weak_ptr<R>>> loads;
+			std::shared_ptr<std::recursive_mutex> mutex;
+			std::size_t		sweepSize;
+			bool			deduplicate;
+		};
+
+		static Context makeContext()
+		{
+			Context context;
+			context.sweepSize = 16;
+			context.deduplicate = false;
+			return context;
+		}
+
+		// Deleters may be invoked by the last shared_ptr on any thread
+		static void setMutex(Context& context, std::shared_ptr<std::recursive_mutex> mutex)
+		{
+			context.mutex = std::move(mutex);
+		}
+
 		static std::shared_ptr<R> makeReturned(const Loaded& loaded)
 		{
 			return loaded.resource;
@@ -174,23 +432,47 @@ namespace detail
 			return std::shared_ptr<R>(stored.resource); // shouldn't throw after assert
 		}
 
+		// If resource is empty, shared is the resource loaded from the same source under another ID (see findLoaded()).
+		// It is passed in rather than looked up again, since the other ID's last shared_ptr may be destroyed meanwhile on another thread.
 		template <typename Map>
-		static Loaded makeLoaded(std::unique_ptr<R>&& resource, ElementRef<Map>&& element)
+		static Loaded makeLoaded(std::unique_ptr<R>&& resource, std::shared_ptr<R>&& shared, ElementRef<Map>&& element,
+			const ResourceLoader<R>& loader, Context& context)
 		{
 			// Tracked object: shared pointer referenced by multiple weak pointers.
 			// If object holding tracked dies, all weak_ptr objects become expired.
 			auto tracked = std::make_shared<char>();
+			Loaded loaded;
+
+			if (resource)
+			{
+				// Deleter for shared_ptr. Users will hold shared_ptrs with this deleter, so
+				// the last one will erase the element from the map.
+				TrackingDeleter<R, Map> deleter;
+				deleter.tracker = tracked;
+				deleter.element = element;
+				deleter.mutex = context.mutex;
 
-			// Deleter for shared_ptr. Users will hold shared_ptrs with this deleter, so
-			// the last one will erase the element from the map.
-			TrackingDeleter<R, Map> deleter;
-			deleter.tracker = tracked;
-			deleter.element = element;
+				loaded.resource = std::shared_ptr<R>(resource.release(), deleter);
+
+				if (context.deduplicate)
+					registerLoaded(context, loader, loaded.resource);
+			}
+			else
+			{
+				// Same as above, but the resource is owned by the other ID's shared_ptr
+				SharingDeleter<R, Map> deleter;
+				deleter.tracker = tracked;
+				deleter.element = element;
+				deleter.mutex = context.mutex;
+				deleter.shared = std::move(shared);
+				assert(deleter.shared);
+
+				R* pointer = deleter.shared.get();
+				loaded.resource = std::shared_ptr<R>(pointer, std::move(deleter));
+			}
 
 			// Create initial object that holds the resource as well as a strong tracked shared_ptr
-			Loaded loaded;
 			loaded.tracked = std::move(tracked);
-			loaded.resource = std::shared_ptr<R>(resource.release(), deleter);
 			return loaded;
 		}
 
@@ -201,6 +483,169 @@ namespace detail
 			stored.resource = std::weak_ptr<R>(loaded.resource);
 			return stored;
 		}
+
+		// Handled: what handles refer to. Expires when the last shared_ptr erases the element from the map.
+		typedef std::weak_ptr<R> Handled;
+
+		static Handled makeHandled(const Stored& stored)
+		{
+			return stored.resource;
+		}
+
+		static bool isExpired(const Handled& handled)
+		{
+			return handled.expired();
+		}
+
+		// The resource may expire after isExpired() has been checked, if the last shared_ptr is destroyed on another thread
+		static std::shared_ptr<R> makeReturned(const Handled& handled)
+		{
+			std::shared_ptr<R> resource = handled.lock();
+			if (!resource)
+				throw ResourceAccessException("Failed to access resource, resource has been released");
+
+			return resource;
+		}
+
+		// Returns the resource loaded from the same source under another ID, so that makeLoaded() can share it, or nullptr
+		static std::shared_ptr<R> findLoaded(const Context& context, const ResourceLoader<R>& loader)
+		{
+			if (!context.deduplicate)
+				return nullptr;
+
+			auto range = context.loads.equal_range(loader.getHash());
+			for (auto itr = range.first; itr != range.second; ++itr)
+			{
+				if (itr->second.first == loader.getInfo())
+					return itr->second.second.lock();
+			}
+
+			return nullptr;
+		}
+
+		static void registerLoaded(Context& context, const ResourceLoader<R>& loader, const std::shared_ptr<R>& resource)
+		{
+			// Forget released resources, in amortized constant time
+			if (context.loads.size() >= context.sweepSize)
+			{
+				for (auto itr = context.loads.begin(); itr != context.loads.end(); )
+				{
+					if (itr->second.second.expired())
+						itr = context.loads.erase(itr);
+					else
+						++itr;
+				}
+
+				context.sweepSize = std::max<std::size_t>(16, 2 * context.loads.size());
+			}
+
+			// A reloaded resource replaces the previous one from the same source
+			auto range = context.loads.equal_range(loader.getHash());
+			for (auto itr = range.first; itr != range.second; ++itr)
+			{
+				if (itr->second.first == loader.getInfo())
+				{
+					itr->second.second = resource;
+					return;
+				}
+			}
+
+			context.loads.insert(std::make_pair(loader.getHash(), std::make_pair(loader.getInfo(), std::weak_ptr<R>(resource))));
+		}
+	};
+
+	// Specialization for cached ownership
+	template <typename R>
+	struct OwnershipModel<Resources::Cached, R>
+	{
+		typedef std::shared_ptr<R>				Returned;
+		typedef std::shared_ptr<const R>		ConstReturned;
+		typedef std::shared_ptr<CacheState<R>>	Context;
+		typedef std::shared_ptr<CacheEntry<R>>	Stored;
+
+		struct Loaded
+		{
+			std::shared_ptr<CacheEntry<R>> entry;
+			std::shared_ptr<R> resource;
+		};
+
+		static Context makeContext()
+		{
+			return std::make_shared<CacheState<R>>();
+		}
+
+		// Resources are never shared between IDs
+		static std::shared_ptr<R> findLoaded(const Context&, const ResourceLoader<R>&)
+		{
+			return nullptr;
+		}
+
+		static std::shared_ptr<R> makeReturned(const Loaded& loaded)
+		{
+			return loaded.resource;
+		}
+
+		// Returns the resource if it is in use or in the cache, otherwise reloads it
+		static std::shared_ptr<R> makeReturned(const Stored& entry)
+		{
+			if (std::shared_ptr<R> used = entry->used.lock())
+				return used;
+
+			std::unique_ptr<R> resource;
+			if (entry->resident)
+				resource = entry->unlink();
+			else
+				resource = entry->loader.load();
+
+			if (!resource)
+				throw ResourceLoadingException("Failed to reload resource \"" + entry->loader.getInfo() + "\"");
+
+			return share(entry, std::move(resource));
+		}
+
+		template <typename Map>
+		static Loaded makeLoaded(std::unique_ptr<R>&& resource, std::shared_ptr<R>&&, ElementRef<Map>&&, const ResourceLoader<R>& loader,
+			Context& context)
+		{
+			Loaded loaded;
+			loaded.entry = std::make_shared<CacheEntry<R>>(loader, context);
+			loaded.resource = share(loaded.entry, std::move(resource));
+			return loaded;
+		}
+
+		static Stored makeStored(Loaded&& loaded)
+		{
+			return std::move(loaded.entry);
+		}
+
+		// Handled: what handles refer to (the entry is only released by the ResourceHolder)
+		typedef std::weak_ptr<CacheEntry<R>> Handled;
+
+		static Handled makeHandled(const Stored& entry)
+		{
+			return entry;
+		}
+
+		static bool isExpired(const Handled& handled)
+		{
+			return handled.expired();
+		}
+
+		static std::shared_ptr<R> makeReturned(const Handled& handled)
+		{
+			return makeReturned(Stored(handled));
+		}
+
+		// Hands out a resource, which returns to the entry when the last shared_ptr is destroyed
+		static std::shared_ptr<R> share(const Stored& entry, std::unique_ptr<R> resource)
+		{
+			CacheDeleter<R> deleter;
+			deleter.entry = entry;
+
+			std::shared_ptr<R> shared(resource.release(), deleter);
+			entry->used = shared;
+			return shared;
+		}
 	};
 
 } // namespace detail
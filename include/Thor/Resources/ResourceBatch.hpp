@@ -0,0 +1,220 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::ResourceBatch
+
+#ifndef THOR_RESOURCEBATCH_HPP
+#define THOR_RESOURCEBATCH_HPP
+
+#include <Thor/Resources/ResourceHolder.hpp>
+#include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/KnownIdStrategy.hpp>
+#include <Thor/Resources/Detail/LoadingThreads.hpp>
+#include <Thor/Config.hpp>
+
+#include <Aurora/Tools/NonCopyable.hpp>
+#include <Aurora/Tools/ForEach.hpp>
+#include <Aurora/SmartPtr/MakeUnique.hpp>
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cassert>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// Resource of a batch, type-erased
+	class BatchItem
+	{
+		public:
+			virtual						~BatchItem() {}
+
+			// Performs the part of the loading that may run on any thread
+			virtual void				prepare() = 0;
+
+			// Completes the loading on the owning thread; returns false on failure
+			virtual bool				finish() = 0;
+
+			// Releases the loaded data without storing it
+			virtual void				discard() = 0;
+
+			virtual std::string			getInfo() const = 0;
+	};
+
+	// Resources of a batch that are stored in the same ResourceHolder, type-erased
+	class BatchGroup
+	{
+		public:
+			virtual						~BatchGroup() {}
+
+			virtual const void*			getHolder() const = 0;
+
+			// Throws ResourceAccessException if an item cannot be stored
+			virtual void				validate() const = 0;
+
+			// Stores the loaded items in the holder; must not fail after validate()
+			virtual void				commit() = 0;
+	};
+
+	struct BatchState;
+
+} // namespace detail
+
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Loads many resources concurrently and stores them all at once.
+/// @details A batch is a manifest of resources, each one with a ResourceHolder, an ID and a ResourceLoader. The resources can belong
+///  to different holders. When the batch is started, the resources are loaded by a pool of threads, while the thread owning the
+///  holders completes them (e.g. texture uploads, see ResourceHolder::acquireAsync()) and reports the progress.
+/// @n@n The resources are committed atomically: only when all of them have been loaded, they are stored in their holders. If a
+///  resource fails to load, none is stored.
+/// @n@n Example:
+/// @code
+/// thor::ResourceBatch batch;
+/// batch.add(textures, "player", thor::Resources::fromFile<sf::Texture>("player.png"));
+/// batch.add(sounds, Sound::Jump, thor::Resources::fromFile<sf::SoundBuffer>("jump.wav"));
+/// batch.setProgressCallback([&] (std::size_t loaded, std::size_t total) { bar.setProgress(1.f * loaded / total); });
+///
+/// batch.start();
+/// while (!batch.update())
+///     drawLoadingScreen();
+/// @endcode
+class THOR_API ResourceBatch : private aurora::NonCopyable
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public types
+	public:
+		/// @brief Function called when a resource has been loaded.
+		/// @details The parameters are the number of resources loaded so far and the total number of resources in the batch.
+		typedef std::function<void(std::size_t loadedCount, std::size_t totalCount)> ProgressCallback;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates an empty batch.
+									ResourceBatch();
+
+		/// @brief Destructor
+		/// @details If the batch is still loading, waits for the resources being loaded by the threads; other resources are discarded.
+									~ResourceBatch();
+
+		/// @brief Adds a resource to the batch.
+		/// @details Must be called before start(). The holder must remain alive and must not be moved while the batch is loading.
+		/// @param holder ResourceHolder in which the resource is stored.
+		/// @param id Value identifying the resource in @a holder.
+		/// @param how Resource loader containing loading information. Determines how the resource is loaded.
+		/// @param known Determines what happens if @a id is already known to @a holder at the time of the commit. With AssumeNew,
+		///  committing the batch fails; with Reuse, the loaded resource is discarded; with Reload, it replaces the known one.
+		/// @throw ResourceAccessException if @a id has already been added for @a holder.
+		template <typename R, typename I, class O, class S>
+		void						add(ResourceHolder<R, I, O, S>& holder, const I& id, const ResourceLoader<R>& how,
+										Resources::KnownIdStrategy known = Resources::AssumeNew);
+
+		/// @brief Sets the function that reports the progress.
+		/// @details The function is called by update() on the owning thread, once per loaded resource.
+		void						setProgressCallback(ProgressCallback callback);
+
+		/// @brief Sets the number of threads used to load the resources.
+		/// @details Must be called before start().
+		/// @param threadCount Number of threads. 0 means as many threads as the hardware supports (default).
+		void						setLoadingThreadCount(unsigned int threadCount);
+
+		/// @brief Starts to load the resources in the background.
+		/// @details Call update() on the owning thread until it returns true.
+		/// @throw ResourceAccessException if a resource cannot be stored because its ID is already known (see add()).
+		void						start();
+
+		/// @brief Completes loaded resources and commits the batch when all have been loaded.
+		/// @details Call this function regularly after start(), for example once per frame of a loading screen. It invokes the
+		///  progress callback for each completed resource.
+		/// @param maxCount Maximal number of resources to complete, to limit the time spent in this call.
+		/// @return True if all resources have been loaded and stored in their holders, false if loading is still in progress.
+		/// @throw ResourceLoadingException if a resource fails to load. The remaining ones are not loaded, and none is stored.
+		/// @throw ResourceAccessException if a resource cannot be stored because its ID is already known (see add()). None is stored.
+		/// @n After an exception, the batch must be cleared before it can be used again.
+		bool						update(std::size_t maxCount = std::numeric_limits<std::size_t>::max());
+
+		/// @brief Loads all resources and waits until they are stored.
+		/// @details Equivalent to start(), followed by update() calls until the batch is committed. The progress callback is invoked
+		///  on the calling thread.
+		/// @throw ResourceLoadingException if a resource fails to load. None is stored.
+		/// @throw ResourceAccessException if a resource cannot be stored because its ID is already known (see add()). None is stored.
+		void						load();
+
+		/// @brief Returns the number of resources loaded so far.
+		///
+		std::size_t					getLoadedCount() const;
+
+		/// @brief Returns the number of resources in the batch.
+		///
+		std::size_t					getTotalCount() const;
+
+		/// @brief Removes all resources from the batch.
+		/// @details Resources that have already been committed remain in their holders. With the RefCounted ownership policy, they
+		///  are only kept alive by the batch until it is cleared or destroyed; store the shared pointers before.
+		void						clear();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Stops the loading threads and releases the loaded data
+		void						abort();
+
+		// Waits until a resource is ready to be completed by update()
+		void						wait();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		std::vector<std::unique_ptr<detail::BatchGroup>>	mGroups;
+		std::vector<std::shared_ptr<detail::BatchItem>>		mItems;
+		std::shared_ptr<detail::BatchState>	mState;
+		ProgressCallback					mProgressCallback;
+		std::size_t							mLoadedCount;
+		unsigned int						mLoadingThreadCount;
+		bool								mStarted;
+		bool								mCommitted;
+		std::unique_ptr<detail::LoadingThreads>	mLoadingThreads;		// Last, to be destroyed first
+};
+
+/// @}
+
+} // namespace thor
+
+#include <Thor/Resources/Detail/ResourceBatch.inl>
+#endif // THOR_RESOURCEBATCH_HPP
@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::ResourceHandle
+
+#ifndef THOR_RESOURCEHANDLE_HPP
+#define THOR_RESOURCEHANDLE_HPP
+
+#include <Thor/Config.hpp>
+
+#include <cstdint>
+
+
+namespace thor
+{
+
+template <typename R, typename I, class O, class S>
+class ResourceHolder;
+
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Handle referring to a resource in a ResourceHolder.
+/// @details A handle allows to access a resource in constant time, without looking up its ID (see ResourceHolder::getHandle()).
+///  When the resource is released from the holder, the handle becomes stale: accessing the resource through it fails, even if
+///  another resource is stored in the meantime. Handles are cheap to copy and compare.
+class ResourceHandle
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Default constructor
+		/// @details Creates a handle that refers to no resource.
+									ResourceHandle()
+		: mIndex(0)
+		, mGeneration(0)
+		{
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Constructor for ResourceHolder
+									ResourceHandle(std::uint32_t index, std::uint32_t generation)
+		: mIndex(index)
+		, mGeneration(generation)
+		{
+		}
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		std::uint32_t				mIndex;				// Slot in the holder's dense storage
+		std::uint32_t				mGeneration;		// Counts releases of the slot; 0 is never used
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Friends
+	template <typename R, typename I, class O, class S>
+	friend class ResourceHolder;
+
+	friend bool operator== (const ResourceHandle& lhs, const ResourceHandle& rhs);
+};
+
+/// @relates ResourceHandle
+/// @brief Checks whether two handles refer to the same resource.
+inline bool operator== (const ResourceHandle& lhs, const ResourceHandle& rhs)
+{
+	return lhs.mIndex == rhs.mIndex && lhs.mGeneration == rhs.mGeneration;
+}
+
+/// @relates ResourceHandle
+/// @brief Checks whether two handles refer to different resources.
+inline bool operator!= (const ResourceHandle& lhs, const ResourceHandle& rhs)
+{
+	return !(lhs == rhs);
+}
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_RESOURCEHANDLE_HPP
@@ -32,16 +32,33 @@
 #include <Thor/Resources/KnownIdStrategy.hpp>
 #include <Thor/Resources/OwnershipModels.hpp>
 #include <Thor/Resources/ResourceExceptions.hpp>
+#include <Thor/Resources/ResourceHandle.hpp>
 #include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/StorageModels.hpp>
+#include <Thor/Resources/Detail/LoadingThreads.hpp>
 
 #include <Aurora/Tools/NonCopyable.hpp>
+#include <Aurora/SmartPtr/MakeUnique.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <limits>
 #include <memory>
-#include <map>
+#include <vector>
+#include <cstdint>
 
 
 namespace thor
 {
+namespace detail
+{
+
+	template <typename R, typename I, class O, class S>
+	class BatchGroupImpl;
+
+} // namespace detail
+
 
 /// @addtogroup Resources
 /// @{
@@ -55,8 +72,14 @@ namespace thor
 /// @tparam I The type identifying the resource. IDs are usually enums or strings. If you don't want to choose IDs yourself,
 ///   let ResourceLoader::getInfo() generate them automatically -- in this case @a I would be std::string.
 /// @tparam O Ownership model. Determines who owns the resources and is responsible of their lifetime. Possible types:
-///  Resources::CentralOwner (default), Resources::RefCounted.
-template <typename R, typename I, class O = Resources::CentralOwner>
+///  Resources::CentralOwner (default), Resources::RefCounted, Resources::Cached.
+/// @tparam S Storage model. Determines how resources are looked up by their ID. Possible types: Resources::OrderedStorage (default),
+///  Resources::HashedStorage.
+/// @n@n Resources can also be acquired asynchronously, see acquireAsync(). The ResourceHolder itself is not thread-safe: all member
+///  functions must be called from the same thread, which is referred to as the owning thread.
+///  To access resources from multiple threads, use ConcurrentResourceHolder.
+/// @n@n Frequently accessed resources can be looked up in constant time through handles, see getHandle().
+template <typename R, typename I, class O = Resources::CentralOwner, class S = Resources::OrderedStorage>
 class ResourceHolder : private aurora::NonCopyable
 {
 	// ---------------------------------------------------------------------------------------------------------------------------
@@ -65,6 +88,29 @@ class ResourceHolder : private aurora::NonCopyable
 		// Abbreviate class containing ownership policy types and functions
 		typedef typename detail::OwnershipModel<O, R>	Om;
 
+		// Map value: stored resource, and index of its slot in the dense storage that handles refer to
+		struct Element
+		{
+			typename Om::Stored		stored;
+			std::uint32_t			slot;
+		};
+
+		struct Slot
+		{
+			typename Om::Handled	handled;
+			std::uint32_t			generation;		// Incremented when the slot is freed, skipping 0
+			bool					used;
+		};
+
+		// Abbreviate class containing storage policy types and functions
+		typedef detail::StorageModel<S, I, Element>		Sm;
+
+		// Asynchronous acquisitions and the state shared with the loading threads
+		typedef detail::PendingAcquisition<R, I, typename Om::Returned>	Pending;
+		typedef detail::LoadingState<Pending>			State;
+		typedef detail::StorageModel<S, I, std::shared_ptr<Pending>>	Pm;
+		typedef typename Pm::Map						PendingMap;
+
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Public types
@@ -73,6 +119,7 @@ class ResourceHolder : private aurora::NonCopyable
 		/// @details The type depends on the ownership policy:
 		///  @li @ref thor::Resources::CentralOwner "CentralOwner": <b>R&</b>
 		///  @li @ref thor::Resources::RefCounted "RefCounted": <b>shared_ptr<R></b>
+		///  @li @ref thor::Resources::Cached "Cached": <b>shared_ptr<R></b>
 		/// @hideinitializer
 		typedef typename Om::Returned			Resource;
 
@@ -80,6 +127,7 @@ class ResourceHolder : private aurora::NonCopyable
 		/// @details The type depends on the ownership policy:
 		///  @li @ref thor::Resources::CentralOwner "CentralOwner": <b>const R&</b>
 		///  @li @ref thor::Resources::RefCounted "RefCounted": <b>shared_ptr<const R></b>
+		///  @li @ref thor::Resources::Cached "Cached": <b>shared_ptr<const R></b>
 		/// @hideinitializer
 		typedef typename Om::ConstReturned		ConstResource;
 
@@ -108,6 +156,81 @@ class ResourceHolder : private aurora::NonCopyable
 		/// @throw ResourceAccessException if a resource associated with @a id is already known and @a known is AssumeNew.
 		Resource					acquire(const I& id, const ResourceLoader<R>& how, Resources::KnownIdStrategy known = Resources::AssumeNew);
 
+		/// @brief Starts to load a new resource in the background, identified as @a id.
+		/// @details The part of the loading that may run on any thread is performed by a loading thread (see setLoadingThreadCount()).
+		///  The rest is performed on the owning thread by finalizeAcquisitions(), which also stores the resource and makes the future
+		///  ready. Until then, @a id is not accessible through operator[]; a call to acquire() for @a id waits for the loading to end,
+		///  unless it uses Reload, which cancels the acquisition.
+		/// @n For the loaders in namespace Resources, sf::Image, sf::Font and sf::SoundBuffer are loaded entirely in the background.
+		///  Textures loaded with Resources::fromFile(), Resources::fromPack() or Resources::fromCachedFile() are decoded in the
+		///  background and uploaded to the graphics card on the owning thread. Other resources are loaded completely on the owning
+		///  thread. Custom loaders can split the work with the two-phase constructor of ResourceLoader.
+		/// @param id Value identifying the resource.
+		/// @param how Resource loader containing loading information. Determines how the resource is loaded.
+		/// @param known Determines what happens if @a id is already known (stored or being acquired). With Reuse, the future refers
+		///  to the known resource. With Reload, a previous acquisition is cancelled, and a stored resource remains accessible until
+		///  the new one replaces it.
+		/// @param priority Acquisitions with higher priority are started earlier by the loading threads.
+		/// @return Future for the resource. If the loading fails, it holds a ResourceLoadingException; if the loader throws an
+		///  exception in the background, the future holds that exception.
+		/// @throw ResourceAccessException if a resource associated with @a id is already known and @a known is AssumeNew.
+		std::shared_future<Resource>	acquireAsync(const I& id, const ResourceLoader<R>& how,
+										Resources::KnownIdStrategy known = Resources::AssumeNew, int priority = 0);
+
+		/// @brief Completes asynchronous acquisitions whose background part has finished.
+		/// @details Call this function regularly on the owning thread, for example once per frame. The acquisitions are completed in
+		///  the order in which their background part finished.
+		/// @param maxCount Maximal number of acquisitions to complete, to limit the time spent in this call.
+		/// @return Number of acquisitions completed, including failed ones.
+		std::size_t					finalizeAcquisitions(std::size_t maxCount = std::numeric_limits<std::size_t>::max());
+
+		/// @brief Cancels the asynchronous acquisition of @a id.
+		/// @details The future returned by acquireAsync() holds a ResourceLoadingException afterwards. If a loading thread is currently
+		///  working on the resource, the result is discarded.
+		/// @param id Value identifying the resource.
+		/// @return True if an acquisition was pending, false otherwise.
+		bool						cancelAcquisition(const I& id);
+
+		/// @brief Checks whether the asynchronous acquisition of @a id has not been completed yet.
+		/// @param id Value identifying the resource.
+		bool						isAcquiring(const I& id) const;
+
+		/// @brief Returns the number of asynchronous acquisitions that have not been completed yet.
+		///
+		std::size_t					getAcquisitionCount() const;
+
+		/// @brief Enables or disables sharing of resources loaded from the same source (only for the RefCounted ownership policy).
+		/// @details If enabled, acquiring a resource whose loader has the same identifier (see ResourceLoader::getInfo()) as the
+		///  loader of a resource currently alive under another ID doesn't load it again; both IDs refer to the same resource then.
+		///  The resource lives until both IDs' shared pointers are destroyed. A known ID acquired with the Reload strategy is
+		///  always loaded again.
+		/// @n Only enable deduplication if equal loader identifiers imply equal resources. This is not the case for loaders whose
+		///  source may change, e.g. Resources::fromStream() or Resources::fromImage() with a modified image.
+		/// @param enabled True to share resources, false to load each one separately (default).
+		void						setDeduplication(bool enabled);
+
+		/// @brief Sets the memory budget of the cache (only for the Cached ownership policy).
+		/// @details Resources that are not referenced by the user are kept in the cache, as long as their total memory does not
+		///  exceed @a budget. Otherwise, the least recently used ones are released (and reloaded when accessed again).
+		/// @param budget Memory in bytes. By default, the budget is unlimited.
+		void						setCacheBudget(std::size_t budget);
+
+		/// @brief Sets the function that determines the memory of a resource in the cache (only for the Cached ownership policy).
+		/// @details By default, images and textures count 4 bytes per pixel, sound buffers 2 bytes per sample; other resources count
+		///  sizeof(R) bytes.
+		/// @param measure Function that returns the memory of a resource in bytes.
+		void						setCacheMeasure(std::function<std::size_t(const R&)> measure);
+
+		/// @brief Returns the memory used by resources in the cache (only for the Cached ownership policy).
+		/// @details Resources that are referenced by the user do not count.
+		std::size_t					getCacheSize() const;
+
+		/// @brief Sets the number of threads used by acquireAsync().
+		/// @details The threads are started at the first asynchronous acquisition. This function must not be called while acquisitions
+		///  are pending. When the ResourceHolder is destroyed, it waits for resources that are being loaded in the background.
+		/// @param threadCount Number of threads. 0 means as many threads as the hardware supports. By default, 1.
+		void						setLoadingThreadCount(unsigned int threadCount);
+
 		/// @brief Unloads the resource currently identified as @a id.
 		/// @details The resource is removed from this resource holder. Depending on the ownership policy,
 		///  it may either be released immediately or live until it is no longer referenced. In any case,
@@ -117,10 +240,12 @@ class ResourceHolder : private aurora::NonCopyable
 		void						release(const I& id);
 
 		/// @brief Accesses a resource using the identifier @a id.
-		/// @details Requires that a resource with the identifier @a id is currently stored in this holder.
+		/// @details Requires that a resource with the identifier @a id is currently stored in this holder. With the Cached ownership
+		///  policy, a resource that has been evicted from the cache is reloaded.
 		/// @param id Value identifying the resource.
 		/// @return Handle to that resource.
 		/// @throw ResourceAccessException If @a id doesn't refer to a currently stored resource.
+		/// @throw ResourceLoadingException If an evicted resource cannot be reloaded.
 		Resource					operator[] (const I& id);
 
 		/// @brief Accesses a resource using the identifier @a id (const overload).
@@ -130,18 +255,99 @@ class ResourceHolder : private aurora::NonCopyable
 		/// @throw ResourceAccessException If @a id doesn't refer to a currently stored resource.
 		ConstResource				operator[] (const I& id) const;
 
+		/// @brief Returns a handle to the resource identified by @a id.
+		/// @details The handle allows to access the resource in constant time through operator[], until the resource is released.
+		/// @param id Value identifying the resource.
+		/// @throw ResourceAccessException If @a id doesn't refer to a currently stored resource.
+		ResourceHandle				getHandle(const I& id) const;
+
+		/// @brief Checks whether @a handle refers to a currently stored resource.
+		/// @details Returns false for default-constructed handles and handles of released resources. With the RefCounted ownership
+		///  policy, a resource is also released when its last shared pointer is destroyed.
+		bool						isValid(ResourceHandle handle) const;
+
+		/// @brief Accesses a resource using a handle.
+		/// @details Accesses the resource in constant time, without looking up its ID.
+		/// @param handle Handle obtained from getHandle() of this holder.
+		/// @return Handle to that resource.
+		/// @throw ResourceAccessException If @a handle doesn't refer to a currently stored resource.
+		/// @throw ResourceLoadingException If an evicted resource cannot be reloaded (Cached ownership policy).
+		Resource					operator[] (ResourceHandle handle);
+
+		/// @brief Accesses a resource using a handle (const overload).
+		/// @details Accesses the resource in constant time, without looking up its ID.
+		/// @param handle Handle obtained from getHandle() of this holder.
+		/// @return Handle to that resource, which does not allow modification of the resource.
+		/// @throw ResourceAccessException If @a handle doesn't refer to a currently stored resource.
+		ConstResource				operator[] (ResourceHandle handle) const;
+
+		/// @brief Accesses a resource using a key other than the ID type.
+		/// @details With Resources::HashedStorage and std::string IDs, @a key can be a C string or a string view (a type with data()
+		///  and size()), which is looked up without constructing a std::string. Otherwise, @a key is converted to @a I.
+		/// @param key Value identifying the resource.
+		/// @return Handle to that resource.
+		/// @throw ResourceAccessException If @a key doesn't refer to a currently stored resource.
+		template <typename K>
+		Resource					operator[] (const K& key);
+
+		/// @brief Accesses a resource using a key other than the ID type (const overload).
+		/// @details See the non-const overload.
+		/// @param key Value identifying the resource.
+		/// @return Handle to that resource, which does not allow modification of the resource.
+		/// @throw ResourceAccessException If @a key doesn't refer to a currently stored resource.
+		template <typename K>
+		ConstResource				operator[] (const K& key) const;
+
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private member functions
 	private:
-		// Load resource (must be new)
-		Resource					load(const I& id, const ResourceLoader<R>& how);
+		// Load resource (must be new); if shareLoaded is true, a resource loaded from the same source may be shared instead
+		Resource					load(const I& id, const ResourceLoader<R>& how, bool shareLoaded);
+
+		// Store loaded resource (id must be new); if original is empty, shared is the resource loaded from the same source
+		Resource					store(const I& id, std::unique_ptr<R> original, std::shared_ptr<R> shared, const ResourceLoader<R>& how);
+
+		// Erase stored resource and free its slot
+		void						erase(typename Sm::Map::iterator itr);
+
+		// Reserve a slot for a stored resource
+		std::uint32_t				allocateSlot(const typename Om::Stored& stored);
+
+		// Return slot to the free list; handles to it become stale
+		void						freeSlot(std::uint32_t index);
+
+		// Slot referred to by handle, or nullptr if the handle is stale
+		const Slot*					findSlot(ResourceHandle handle) const;
+
+		// Complete an acquisition whose background part is finished: store the resource and fulfill the promise
+		void						finalize(std::shared_ptr<Pending> acquisition);
+
+		// Complete a pending acquisition immediately, waiting for the loading thread if it has already begun
+		void						finalizeNow(typename PendingMap::iterator pendingItr);
 
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private variables
 	private:
-		std::map<I, typename Om::Stored>	mMap;
+		typename Sm::Map					mMap;
+		typename Om::Context				mContext;
+		std::vector<Slot>					mSlots;
+		std::vector<std::uint32_t>			mFreeSlots;
+		std::size_t							mSlotSweepSize;			// Slot count at which slots of expired resources are freed
+		PendingMap							mPending;
+		std::shared_ptr<State>				mState;
+		unsigned int						mLoadingThreadCount;
+		std::unique_ptr<detail::LoadingThreads>	mLoadingThreads;		// Last, to be destroyed first
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Friends
+	template <typename R2, typename I2, class O2, class S2>
+	friend class detail::BatchGroupImpl;
+
+	template <typename R2, typename I2, class O2, class S2>
+	friend class ConcurrentResourceHolder;
 };
 
 /// @}
@@ -54,6 +54,10 @@ class ResourceLoader
 		///
 		typedef std::function< std::unique_ptr<R>() > Loader;
 
+		/// @brief Function type to prepare a resource in the background.
+		/// @details Returns a Loader that completes the resource, or an empty function in case of loading failure.
+		typedef std::function< Loader() > Preparer;
+
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Public member functions
@@ -65,7 +69,25 @@ class ResourceLoader
 		///  contain debug information in case of loading failures.
 									ResourceLoader(std::function< std::unique_ptr<R>() > loader, std::string id)
 		: mLoader(std::move(loader))
+		, mPreparer()
+		, mId(std::move(id))
+		, mHash(std::hash<std::string>()(mId))
+		{
+		}
+
+		/// @brief Constructor for loading in two phases
+		/// @details When the resource is acquired asynchronously, the expensive part of the loading (such as reading and decoding a file)
+		///  runs on a background thread, while the rest (such as uploading to the graphics card) runs on the thread owning the ResourceHolder.
+		/// @param preparer Function performing the first phase, which must be safe to call from any thread. Shall return the function
+		///  that performs the second phase and returns the resource as described at the other constructor, or an empty function in case
+		///  of loading failure. Neither function shall throw any exceptions.
+		/// @param id Identifier which is equal to another identifier if and only if the key refers to the same resource. Can also
+		///  contain debug information in case of loading failures.
+									ResourceLoader(std::function< Loader() > preparer, std::string id)
+		: mLoader()
+		, mPreparer(std::move(preparer))
 		, mId(std::move(id))
+		, mHash(std::hash<std::string>()(mId))
 		{
 		}
 
@@ -73,22 +95,43 @@ class ResourceLoader
 		/// @return Unique pointer to resource if loaded, nullptr in case of loading failure.
 		std::unique_ptr<R>			load() const
 		{
-			return mLoader();
+			if (!mPreparer)
+				return mLoader();
+
+			Loader finisher = mPreparer();
+			return finisher ? finisher() : nullptr;
+		}
+
+		/// @brief Performs the part of the loading that may run on any thread.
+		/// @details For loaders created with a single function, nothing is done here; the whole loading happens in the returned function.
+		/// @return Function that completes the loading on the thread owning the resource, or an empty function in case of loading failure.
+		Loader						prepare() const
+		{
+			return mPreparer ? mPreparer() : mLoader;
 		}
 
 		/// @brief Returns a string describing the resource loader.
 		///
-		std::string					getInfo() const
+		const std::string&			getInfo() const
 		{
 			return mId;
 		}
 
+		/// @brief Returns a hash value of the identifier.
+		/// @details The hash is computed once at construction. Loaders with equal identifiers have equal hashes.
+		std::size_t					getHash() const
+		{
+			return mHash;
+		}
+
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 	// Private variables
 	private:
 		Loader						mLoader;
+		Preparer					mPreparer;
 		std::string					mId;
+		std::size_t					mHash;
 };
 
 /// @}
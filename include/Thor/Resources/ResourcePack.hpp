@@ -0,0 +1,129 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Class thor::ResourcePack
+
+#ifndef THOR_RESOURCEPACK_HPP
+#define THOR_RESOURCEPACK_HPP
+
+#include <Thor/Config.hpp>
+
+#include <Aurora/Tools/NonCopyable.hpp>
+
+#include <string>
+#include <vector>
+
+
+namespace thor
+{
+
+/// @addtogroup Resources
+/// @{
+
+/// @brief Archive that stores many resource files in a single file.
+/// @details The pack file is mapped into memory as a whole, so that its entries can be accessed without any file operations or
+///  copies. Together with Resources::fromPack(), a ResourceHolder can load resources directly from the mapped memory.
+/// @n@n Pack files are created with create(). The entries are named like the files they have been created from, and are stored
+///  in an index sorted by name, followed by the file contents at 16-byte aligned offsets.
+class THOR_API ResourcePack : private aurora::NonCopyable
+{
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Public member functions
+	public:
+		/// @brief Writes a pack file containing the specified files.
+		/// @param packFilename Name of the pack file to create.
+		/// @param filenames Files to store in the pack. Each entry is named like its file, e.g. "media/image.png".
+		/// @return true if the pack file has been written; false if a file could not be read, the pack file could not be written
+		///  or a filename appears twice.
+		static bool					create(const std::string& packFilename, const std::vector<std::string>& filenames);
+
+		/// @brief Default constructor
+		/// @details Creates a pack without entries.
+									ResourcePack();
+
+		/// @brief Destructor
+		/// @details Unmaps the pack file. Pointers to its entries become invalid.
+									~ResourcePack();
+
+		/// @brief Maps a pack file into memory.
+		/// @details A previously opened pack file is closed.
+		/// @param filename Name of the pack file, as written by create().
+		/// @return true if the pack file has been opened, false if it could not be mapped or is not a valid pack file.
+		bool						openFromFile(const std::string& filename);
+
+		/// @brief Unmaps the pack file.
+		/// @details Pointers to its entries become invalid.
+		void						close();
+
+		/// @brief Looks up an entry.
+		/// @details The lookup is a binary search and doesn't allocate memory.
+		/// @param name Name of the entry.
+		/// @param[out] data Pointer to the contents of the entry. Remains valid until the pack is closed.
+		/// @param[out] size Size of the contents in bytes.
+		/// @return true if the entry exists; false otherwise, in which case @a data and @a size are unchanged.
+		bool						findEntry(const std::string& name, const void*& data, std::size_t& size) const;
+
+		/// @brief Returns the number of entries.
+		///
+		std::size_t					getEntryCount() const;
+
+		/// @brief Returns the name of an entry.
+		/// @param index Index of the entry, in [0, getEntryCount()[. Entries are sorted by name.
+		std::string					getEntryName(std::size_t index) const;
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private types
+	private:
+		struct Entry
+		{
+			const char*				name;
+			std::size_t				nameLength;
+			const char*				data;
+			std::size_t				size;
+		};
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private member functions
+	private:
+		// Reads and checks the index of the mapped file
+		bool						readIndex();
+
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+	// Private variables
+	private:
+		const char*					mMapping;
+		std::size_t					mMappingSize;
+		std::vector<Entry>			mEntries;
+};
+
+/// @}
+
+} // namespace thor
+
+#endif // THOR_RESOURCEPACK_HPP
@@ -30,7 +30,10 @@
 #define THOR_SFMLLOADERS_HPP
 
 #include <Thor/Resources/ResourceLoader.hpp>
+#include <Thor/Resources/ResourcePack.hpp>
+#include <Thor/Resources/ImageCache.hpp>
 #include <Thor/Resources/Detail/ResourceLoaderHelpers.hpp>
+#include <Thor/Graphics/AtlasBuilder.hpp>
 
 #include <Aurora/Meta/Templates.hpp>
 
@@ -54,8 +57,9 @@ namespace Resources
 	template <class R>
 	ResourceLoader<R> fromFile(const std::string& filename)
 	{
-		return detail::makeResourceLoader<R>(
+		return detail::makeDecodingLoader<R>(
 			[=] (R& resource) { return resource.loadFromFile(filename); },
+			detail::FileSource{filename}, sf::IntRect(),
 			detail::Tagger("File") << filename);
 	}
 
@@ -66,11 +70,30 @@ namespace Resources
 	template <class R, typename T>
 	ResourceLoader<R> fromFile(const std::string& filename, T arg1)
 	{
-		return detail::makeResourceLoader<R>(
+		return detail::makeDecodingLoader<R>(
 			[=] (R& resource) { return resource.loadFromFile(filename, arg1); },
+			detail::FileSource{filename}, arg1,
 			detail::Tagger("File") << filename << arg1);
 	}
 
+	/// @brief Load the resource (usually sf::Texture, sf::Image or thor::BigTexture) from an image file, using a disk cache.
+	/// @details If @a cache contains the decoded pixels of the file, the image is created from them without decoding the file.
+	///  Otherwise, the file is decoded and the pixels are stored in the cache. The cache must outlive the loader.
+	/// @param cache Cache of decoded images.
+	/// @param filename The name of the image file from which you want to load the resource.
+	/// @return Resource loader which is going to invoke <i>ImageCache::loadImage(image, filename)</i>, followed by
+	///  <i>loadFromImage(image)</i> unless the resource is an image itself.
+	template <class R>
+	ResourceLoader<R> fromCachedFile(const ImageCache& cache, const std::string& filename)
+	{
+		detail::CachedFileSource source = {&cache, filename};
+
+		return detail::makeDecodingLoader<R>(
+			[=] (R& resource) { return detail::loadFromImageSource(resource, source); },
+			source, sf::IntRect(),
+			detail::Tagger("CachedFile") << filename);
+	}
+
 	/// @brief Load the resource from a file in memory.
 	/// @param arg1 Usually <i>const void*</i> for a pointer in memory; alternatively <i>std::string</i> for shader.
 	/// @param arg2 Usually <i>std::size_t</i> for the data length in bytes; alternatively <i>std::string</i> or <i>sf::Shader::Type</i> for shader.
@@ -96,6 +119,45 @@ namespace Resources
 			detail::Tagger("Memory") << arg1 << arg2 << arg3);
 	}
 
+	/// @brief Load the resource from an entry of a resource pack.
+	/// @details The resource is loaded directly from the memory to which the pack file is mapped, without copying. The pack must
+	///  remain open as long as the loader is used, and as long as resources that keep accessing their data (such as sf::Font) exist.
+	/// @param pack Opened resource pack.
+	/// @param name The name of the entry, which is usually the name of the file from which the pack has been created.
+	/// @return Resource loader which is going to invoke <i>loadFromMemory(data, size)</i> with the entry's contents. Fails to load
+	///  if @a pack has no such entry.
+	template <class R>
+	ResourceLoader<R> fromPack(const ResourcePack& pack, const std::string& name)
+	{
+		detail::MemorySource source = {nullptr, 0};
+		pack.findEntry(name, source.data, source.size);
+
+		return detail::makeDecodingLoader<R>(
+			[=] (R& resource) { return source.data != nullptr && resource.loadFromMemory(source.data, source.size); },
+			source, sf::IntRect(),
+			detail::Tagger("Pack") << &pack << name);
+	}
+
+	/// @brief Load the resource from an entry of a resource pack.
+	/// @details The resource is loaded directly from the memory to which the pack file is mapped, without copying. The pack must
+	///  remain open as long as the loader is used, and as long as resources that keep accessing their data (such as sf::Font) exist.
+	/// @param pack Opened resource pack.
+	/// @param name The name of the entry, which is usually the name of the file from which the pack has been created.
+	/// @param arg1 An additional argument (for example sf::IntRect at sf::Texture).
+	/// @return Resource loader which is going to invoke <i>loadFromMemory(data, size, arg1)</i> with the entry's contents. Fails to
+	///  load if @a pack has no such entry.
+	template <class R, typename T>
+	ResourceLoader<R> fromPack(const ResourcePack& pack, const std::string& name, T arg1)
+	{
+		detail::MemorySource source = {nullptr, 0};
+		pack.findEntry(name, source.data, source.size);
+
+		return detail::makeDecodingLoader<R>(
+			[=] (R& resource) { return source.data != nullptr && resource.loadFromMemory(source.data, source.size, arg1); },
+			source, arg1,
+			detail::Tagger("Pack") << &pack << name << arg1);
+	}
+
 	/// @brief Load the resource from an input stream.
 	/// @param stream Source stream to read from.
 	/// @return Resource loader which is going to invoke <i>loadFromStream(stream)</i>.
@@ -190,6 +252,19 @@ namespace Resources
 			detail::Tagger("Image") << &image << area);
 	}
 
+	/// @brief Load the resource (usually thor::ImageAtlas) by packing the images of a builder.
+	/// @details Loading and packing the images runs on a loading thread if the atlas is acquired asynchronously. The builder must
+	///  outlive the loader and must not be modified while the resource is loaded.
+	/// @param builder Builder describing the images to pack.
+	/// @return Resource loader which is going to invoke <i>loadFromBuilder(builder)</i>.
+	template <class R>
+	ResourceLoader<R> fromAtlasBuilder(const AtlasBuilder& builder)
+	{
+		return detail::makeResourceLoader<R>(
+			[&builder] (R& resource) { return resource.loadFromBuilder(builder); },
+			detail::Tagger("AtlasBuilder") << &builder);
+	}
+
 } // namespace Resources
 
 /// @}
@@ -0,0 +1,247 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+/// @file
+/// @brief Storage models for thor::ResourceHolder
+
+#ifndef THOR_STORAGEMODELS_HPP
+#define THOR_STORAGEMODELS_HPP
+
+#include <Thor/Config.hpp>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <type_traits>
+#include <utility>
+#include <cstring>
+
+
+namespace thor
+{
+
+/// @addtogroup Resources
+/// @{
+
+namespace Resources
+{
+
+	/// @brief Ordered storage policy
+	/// @details The ResourceHolder stores its resources in a std::map. Accessing a resource takes logarithmic time, and the ID type
+	///  must be comparable with operator<.
+	/// @n@n This is the default storage policy.
+	struct OrderedStorage {};
+
+	/// @brief Hashed storage policy
+	/// @details The ResourceHolder stores its resources in a hash table, so accessing a resource takes constant time on average.
+	///  The ID type must be an enum, or a type for which std::hash is specialized (such as integers or std::string).
+	/// @n@n With std::string IDs, ResourceHolder::operator[] also accepts C strings and string views (any type with data() and size()
+	///  member functions, such as std::string_view), without constructing a std::string.
+	struct HashedStorage {};
+
+} // namespace Resources
+
+/// @}
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+namespace detail
+{
+
+	// Hash function for IDs. Enums are hashed via their underlying type, since std::hash does not support them before C++14.
+	template <typename I, bool IsEnum = std::is_enum<I>::value>
+	struct IdHash
+	{
+		std::size_t operator() (const I& id) const
+		{
+			return std::hash<I>()(id);
+		}
+	};
+
+	template <typename I>
+	struct IdHash<I, true>
+	{
+		std::size_t operator() (const I& id) const
+		{
+			typedef typename std::underlying_type<I>::type Underlying;
+			return std::hash<Underlying>()(static_cast<Underlying>(id));
+		}
+	};
+
+	// Key in hashed storage
+	template <typename I>
+	struct HashedKey
+	{
+		explicit HashedKey(const I& id)
+		: id(id)
+		{
+		}
+
+		// Key to look up a value that is convertible to the ID
+		template <typename K>
+		static HashedKey lookup(const K& key)
+		{
+			return HashedKey(static_cast<I>(key));
+		}
+
+		std::size_t hash() const
+		{
+			return IdHash<I>()(id);
+		}
+
+		bool operator== (const HashedKey& rhs) const
+		{
+			return id == rhs.id;
+		}
+
+		I id;
+	};
+
+	// Key in hashed storage for strings. Stored keys own their string, while keys for lookup only refer to the caller's characters.
+	template <>
+	struct HashedKey<std::string>
+	{
+		explicit HashedKey(const std::string& id)
+		: id(id)
+		, chars(nullptr)
+		, size(id.size())
+		{
+		}
+
+		HashedKey(const char* chars, std::size_t size)
+		: id()
+		, chars(chars)
+		, size(size)
+		{
+		}
+
+		static HashedKey lookup(const char* key)
+		{
+			return HashedKey(key, std::strlen(key));
+		}
+
+		// For std::string and string views
+		template <typename S>
+		static HashedKey lookup(const S& key)
+		{
+			return HashedKey(key.data(), key.size());
+		}
+
+		// Points to own string for stored keys; must not be cached, as the string's buffer moves with the key
+		const char* data() const
+		{
+			return chars ? chars : id.data();
+		}
+
+		// FNV-1a, so that stored and lookup keys are hashed alike
+		std::size_t hash() const
+		{
+			const char* begin = data();
+
+			std::size_t result = static_cast<std::size_t>(2166136261u);
+			for (std::size_t i = 0; i < size; ++i)
+				result = (result ^ static_cast<unsigned char>(begin[i])) * static_cast<std::size_t>(16777619u);
+
+			return result;
+		}
+
+		bool operator== (const HashedKey& rhs) const
+		{
+			return size == rhs.size && std::memcmp(data(), rhs.data(), size) == 0;
+		}
+
+		std::string			id;
+		const char*			chars;
+		std::size_t			size;
+	};
+
+	template <typename I>
+	struct HashedKeyHash
+	{
+		std::size_t operator() (const HashedKey<I>& key) const
+		{
+			return key.hash();
+		}
+	};
+
+	// Class to dispatch between storage models, using partial template specialization
+	template <typename Model, typename I, typename Value>
+	struct StorageModel;
+
+	// Specialization for ordered storage
+	template <typename I, typename Value>
+	struct StorageModel<Resources::OrderedStorage, I, Value>
+	{
+		typedef std::map<I, Value>		Map;
+
+		template <typename K>
+		static typename Map::iterator find(Map& map, const K& key)
+		{
+			return map.find(key);
+		}
+
+		template <typename K>
+		static typename Map::const_iterator find(const Map& map, const K& key)
+		{
+			return map.find(key);
+		}
+
+		// Inserts a default-constructed value (id must be new)
+		static typename Map::iterator insert(Map& map, const I& id)
+		{
+			return map.insert(std::make_pair(id, Value())).first;
+		}
+	};
+
+	// Specialization for hashed storage
+	template <typename I, typename Value>
+	struct StorageModel<Resources::HashedStorage, I, Value>
+	{
+		typedef std::unordered_map<HashedKey<I>, Value, HashedKeyHash<I>>	Map;
+
+		template <typename K>
+		static typename Map::iterator find(Map& map, const K& key)
+		{
+			return map.find(HashedKey<I>::lookup(key));
+		}
+
+		template <typename K>
+		static typename Map::const_iterator find(const Map& map, const K& key)
+		{
+			return map.find(HashedKey<I>::lookup(key));
+		}
+
+		static typename Map::iterator insert(Map& map, const I& id)
+		{
+			return map.insert(std::make_pair(HashedKey<I>(id), Value())).first;
+		}
+	};
+
+} // namespace detail
+} // namespace thor
+
+#endif // THOR_STORAGEMODELS_HPP
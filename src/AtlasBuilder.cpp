@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Graphics/AtlasBuilder.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+
+namespace thor
+{
+
+AtlasBuilder::AtlasBuilder()
+: mEntries()
+, mPadding(1u)
+, mMaximalSize(4096u, 4096u)
+{
+}
+
+void AtlasBuilder::addImage(const std::string& name, const sf::Image& image)
+{
+	Entry& entry = mEntries[name];
+	entry.image = std::make_shared<sf::Image>(image);
+	entry.filename.clear();
+}
+
+void AtlasBuilder::addImageFile(const std::string& name, const std::string& filename)
+{
+	Entry& entry = mEntries[name];
+	entry.image.reset();
+	entry.filename = filename;
+}
+
+void AtlasBuilder::setPadding(unsigned int padding)
+{
+	mPadding = padding;
+}
+
+void AtlasBuilder::setMaximalSize(sf::Vector2u size)
+{
+	mMaximalSize = size;
+}
+
+std::size_t AtlasBuilder::getImageCount() const
+{
+	return mEntries.size();
+}
+
+void AtlasBuilder::clear()
+{
+	mEntries.clear();
+}
+
+} // namespace thor
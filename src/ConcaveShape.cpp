@@ -26,6 +26,7 @@
 #include <Thor/Shapes/ConcaveShape.hpp>
 #include <Thor/Shapes/Shapes.hpp>
 #include <Thor/Math/Triangulation.hpp>
+#include <Thor/Vectors/VectorAlgebra2D.hpp>
 
 #include <Aurora/Tools/ForEach.hpp>
 
@@ -36,12 +37,110 @@
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <cstdint>
 
 
 // TODO: Possible optimization: Don't recompute everything if a single attribute such as fill color changes.
 
 namespace thor
 {
+namespace
+{
+
+	// Polygons up to this size are triangulated by ear clipping, larger ones by the constrained Delaunay triangulation
+	const std::size_t MaxEarClippingPoints = 32;
+
+	// Checks whether the corner current, together with its neighbors in the remaining polygon, forms an ear:
+	// The corner must be convex, and no other remaining point may lie inside the triangle or on its border.
+	bool isEar(const sf::Vector2f* points, const std::uint8_t* previous, const std::uint8_t* next, std::uint8_t current, float orientation)
+	{
+		const sf::Vector2f a = points[previous[current]];
+		const sf::Vector2f b = points[current];
+		const sf::Vector2f c = points[next[current]];
+
+		if (orientation * crossProduct(b - a, c - b) <= 0.f)
+			return false;
+
+		for (std::uint8_t i = next[next[current]]; i != previous[current]; i = next[i])
+		{
+			const sf::Vector2f p = points[i];
+
+			if (orientation * crossProduct(b - a, p - a) >= 0.f
+			 && orientation * crossProduct(c - b, p - b) >= 0.f
+			 && orientation * crossProduct(a - c, p - c) >= 0.f)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Triangulates a simple polygon with at most MaxEarClippingPoints points by cutting off one ear after another.
+	// Writes 3 * (count-2) point indices to indicesOut. Returns false if the polygon is degenerate (e.g. zero area, duplicate
+	// points or crossing edges prevent finding an ear); indicesOut is then unspecified.
+	bool clipEars(const sf::Vector2f* points, std::size_t count, std::uint8_t* indicesOut)
+	{
+		assert(count >= 3 && count <= MaxEarClippingPoints);
+
+		// Determine orientation from the sign of the polygon's area
+		float area = 0.f;
+		for (std::size_t i = 0; i < count; ++i)
+			area += crossProduct(points[i], points[(i+1) % count]);
+
+		if (area == 0.f)
+			return false;
+
+		const float orientation = (area > 0.f) ? 1.f : -1.f;
+
+		// Remaining polygon as doubly linked ring
+		std::uint8_t previous[MaxEarClippingPoints];
+		std::uint8_t next[MaxEarClippingPoints];
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			previous[i] = static_cast<std::uint8_t>((i + count - 1) % count);
+			next[i] = static_cast<std::uint8_t>((i + 1) % count);
+		}
+
+		std::uint8_t current = 0;
+		std::size_t remaining = count;
+		std::size_t failedAttempts = 0;
+
+		while (remaining > 3)
+		{
+			if (isEar(points, previous, next, current, orientation))
+			{
+				*indicesOut++ = previous[current];
+				*indicesOut++ = current;
+				*indicesOut++ = next[current];
+
+				// Cut off the ear
+				next[previous[current]] = next[current];
+				previous[next[current]] = previous[current];
+				current = next[current];
+
+				--remaining;
+				failedAttempts = 0;
+			}
+			else if (++failedAttempts > remaining)
+			{
+				// A whole round without ear
+				return false;
+			}
+			else
+			{
+				current = next[current];
+			}
+		}
+
+		*indicesOut++ = previous[current];
+		*indicesOut++ = current;
+		*indicesOut++ = next[current];
+		return true;
+	}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
 
 struct ConcaveShape::TriangleGenerator
 {
@@ -208,8 +307,22 @@ void ConcaveShape::ensureDecomposed() const
 	if (!mNeedsDecomposition)
 		return;
 
-	// Split the concave polygon into convex triangles
-	triangulatePolygon(mPoints.begin(), mPoints.end(), TriangleGenerator(mTriangleVertices, mFillColor));
+	// Split the concave polygon into convex triangles. Small polygons are handled by ear clipping, which works on the stack;
+	// if it fails because of degenerate input, or for large polygons, the constrained Delaunay triangulation is used.
+	std::uint8_t indices[3 * (MaxEarClippingPoints - 2)];
+	const std::size_t pointCount = mPoints.size();
+
+	if (pointCount >= 3 && pointCount <= MaxEarClippingPoints && clipEars(mPoints.data(), pointCount, indices))
+	{
+		mTriangleVertices.clear();
+		for (std::size_t i = 0; i < 3 * (pointCount - 2); ++i)
+			mTriangleVertices.append(sf::Vertex(mPoints[indices[i]], mFillColor));
+	}
+	else
+	{
+		triangulatePolygon(mPoints.begin(), mPoints.end(), TriangleGenerator(mTriangleVertices, mFillColor));
+	}
+
 	mNeedsDecomposition = false;
 }
 
@@ -28,11 +28,74 @@
 #include <Thor/Vectors/VectorAlgebra2D.hpp>
 #include <Thor/Vectors/PolarVector2.hpp>
 
+#include <Aurora/Tools/ForEach.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 #include <cassert>
+#include <cmath>
 
 
 namespace thor
 {
+namespace detail
+{
+
+	int sampleBuiltin(DistributionKind kind, int first, int second)
+	{
+		assert(kind == ConstantDistribution || kind == UniformDistribution);
+		return (kind == UniformDistribution) ? random(first, second) : first;
+	}
+
+	unsigned int sampleBuiltin(DistributionKind kind, unsigned int first, unsigned int second)
+	{
+		assert(kind == ConstantDistribution || kind == UniformDistribution);
+		return (kind == UniformDistribution) ? random(first, second) : first;
+	}
+
+	float sampleBuiltin(DistributionKind kind, float first, float second)
+	{
+		assert(kind == ConstantDistribution || kind == UniformDistribution);
+		return (kind == UniformDistribution) ? random(first, second) : first;
+	}
+
+	sf::Time sampleBuiltin(DistributionKind kind, sf::Time first, sf::Time second)
+	{
+		assert(kind == ConstantDistribution || kind == UniformDistribution);
+		return (kind == UniformDistribution) ? sf::seconds(random(first.asSeconds(), second.asSeconds())) : first;
+	}
+
+	sf::Vector2f sampleBuiltin(DistributionKind kind, sf::Vector2f first, sf::Vector2f second)
+	{
+		switch (kind)
+		{
+			// first: center, second: half-size
+			case RectDistribution:
+				return sf::Vector2f(
+					randomDev(first.x, second.x),
+					randomDev(first.y, second.y));
+
+			// first: center, second.x: radius
+			case CircleDistribution:
+			{
+				sf::Vector2f radiusVector = PolarVector2f(second.x * std::sqrt(random(0.f, 1.f)), random(0.f, 360.f));
+				return first + radiusVector;
+			}
+
+			default:
+				assert(kind == ConstantDistribution);
+				return first;
+		}
+	}
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
 namespace Distributions
 {
 	namespace
@@ -42,10 +105,343 @@ namespace Distributions
 		{
 			assert(min <= max);
 
-			return [=] () -> T
+			return detail::makeBuiltinDistribution(detail::UniformDistribution, min, max);
+		}
+
+		// Walker's alias table: chooses an index with probability proportional to its weight, in constant time.
+		// Built with Vose's method: each slot keeps a share of its own index and refers to an alias for the rest.
+		class AliasTable
+		{
+			public:
+				explicit AliasTable(const std::vector<double>& weights)
+				: mProbabilities(weights.size())
+				, mAliases(weights.size())
+				{
+					const std::size_t size = weights.size();
+					assert(size > 0);
+
+					double sum = 0.0;
+					AURORA_FOREACH(double weight, weights)
+						sum += weight;
+
+					// Scale weights so that the average is 1, and split them into under- and overfull slots
+					std::vector<double> scaled(size);
+					std::vector<std::size_t> small;
+					std::vector<std::size_t> large;
+
+					for (std::size_t i = 0; i < size; ++i)
+					{
+						scaled[i] = weights[i] * size / sum;
+						(scaled[i] < 1.0 ? small : large).push_back(i);
+					}
+
+					// Fill each underfull slot with the excess of an overfull one
+					while (!small.empty() && !large.empty())
+					{
+						std::size_t less = small.back();
+						std::size_t more = large.back();
+						small.pop_back();
+
+						mProbabilities[less] = static_cast<float>(scaled[less]);
+						mAliases[less] = static_cast<unsigned int>(more);
+
+						scaled[more] -= 1.0 - scaled[less];
+						if (scaled[more] < 1.0)
+						{
+							large.pop_back();
+							small.push_back(more);
+						}
+					}
+
+					// Remaining slots are full (up to rounding errors); they alias themselves in case random() returns exactly 1
+					AURORA_FOREACH(std::size_t i, large)
+					{
+						mProbabilities[i] = 1.f;
+						mAliases[i] = static_cast<unsigned int>(i);
+					}
+					AURORA_FOREACH(std::size_t i, small)
+					{
+						mProbabilities[i] = 1.f;
+						mAliases[i] = static_cast<unsigned int>(i);
+					}
+				}
+
+				std::size_t sample() const
+				{
+					unsigned int slot = random(0u, static_cast<unsigned int>(mProbabilities.size() - 1));
+
+					if (random(0.f, 1.f) <= mProbabilities[slot])
+						return slot;
+					else
+						return mAliases[slot];
+				}
+
+			private:
+				std::vector<float>			mProbabilities;
+				std::vector<unsigned int>	mAliases;
+		};
+
+		// Pixels with positive weight, together with the alias table to choose among them
+		struct PixelMask
+		{
+			PixelMask(std::vector<sf::Vector2f> pixels, const std::vector<double>& weights)
+			: pixels(std::move(pixels))
+			, table(weights)
+			{
+			}
+
+			std::vector<sf::Vector2f>	pixels;
+			AliasTable					table;
+		};
+
+		// Creates a distribution over the pixels of image, weighted by weightFn(color)
+		template <typename Fn>
+		Distribution<sf::Vector2f> pixelDistribution(const sf::Image& image, sf::Vector2f topLeft, Fn weightFn)
+		{
+			const sf::Vector2u size = image.getSize();
+
+			std::vector<sf::Vector2f> pixels;
+			std::vector<double> weights;
+
+			for (unsigned int y = 0; y < size.y; ++y)
+			{
+				for (unsigned int x = 0; x < size.x; ++x)
+				{
+					double weight = weightFn(image.getPixel(x, y));
+					if (weight > 0.0)
+					{
+						pixels.push_back(topLeft + sf::Vector2f(static_cast<float>(x), static_cast<float>(y)));
+						weights.push_back(weight);
+					}
+				}
+			}
+
+			// The table is shared between all copies of the distribution
+			assert(!pixels.empty());
+			std::shared_ptr<const PixelMask> mask = std::make_shared<PixelMask>(std::move(pixels), weights);
+
+			return [mask] () -> sf::Vector2f
+			{
+				sf::Vector2f pixel = mask->pixels[mask->table.sample()];
+				return pixel + sf::Vector2f(random(0.f, 1.f), random(0.f, 1.f));
+			};
+		}
+
+		// Maps a point in the unit square [0,1[^2 to a rectangle
+		sf::Vector2f mapToRect(sf::Vector2f unit, sf::Vector2f center, sf::Vector2f halfSize)
+		{
+			return sf::Vector2f(
+				center.x + (2.f * unit.x - 1.f) * halfSize.x,
+				center.y + (2.f * unit.y - 1.f) * halfSize.y);
+		}
+
+		// Maps a point in the unit square [0,1[^2 to a circle, preserving area (and thus the uniformity of the input)
+		sf::Vector2f mapToCircle(sf::Vector2f unit, sf::Vector2f center, float radius)
+		{
+			sf::Vector2f radiusVector = PolarVector2f(radius * std::sqrt(unit.x), 360.f * unit.y);
+			return center + radiusVector;
+		}
+
+		// Van der Corput radical inverse of index in the given base
+		float radicalInverse(unsigned int index, unsigned int base)
+		{
+			const double inverseBase = 1.0 / base;
+
+			double result = 0.0;
+			double factor = inverseBase;
+			for (; index > 0; index /= base)
+			{
+				result += (index % base) * factor;
+				factor *= inverseBase;
+			}
+
+			return static_cast<float>(result);
+		}
+
+		// State of a Halton sequence in bases 2 and 3, with a Cranley-Patterson rotation
+		class HaltonSequence
+		{
+			public:
+				HaltonSequence()
+				: mIndex(1)
+				, mShift(random(0.f, 1.f), random(0.f, 1.f))
+				{
+				}
+
+				sf::Vector2f next()
+				{
+					sf::Vector2f point(
+						radicalInverse(mIndex, 2) + mShift.x,
+						radicalInverse(mIndex, 3) + mShift.y);
+					++mIndex;
+
+					// Wrap around to stay in unit square
+					point.x -= std::floor(point.x);
+					point.y -= std::floor(point.y);
+					return point;
+				}
+
+			private:
+				unsigned int		mIndex;
+				sf::Vector2f		mShift;
+		};
+
+		// State of a two-dimensional Sobol sequence, generated in Gray code order, with a random digital shift
+		class SobolSequence
+		{
+			public:
+				SobolSequence()
+				: mIndex(0)
+				, mX(random(0u, 0xffffffffu))
+				, mY(random(0u, 0xffffffffu))
+				{
+					// First dimension: van der Corput sequence in base 2. Second dimension: primitive polynomial x+1.
+					mDirectionsX[0] = mDirectionsY[0] = 1u << 31;
+					for (std::size_t i = 1; i < 32; ++i)
+					{
+						mDirectionsX[i] = mDirectionsX[i-1] >> 1;
+						mDirectionsY[i] = mDirectionsY[i-1] ^ (mDirectionsY[i-1] >> 1);
+					}
+				}
+
+				sf::Vector2f next()
+				{
+					const float scale = 1.f / 4294967296.f;
+					sf::Vector2f point(mX * scale, mY * scale);
+
+					// Gray code: next point differs in the direction number of the lowest zero bit of the index
+					std::size_t bit = 0;
+					for (unsigned int index = mIndex; index & 1u; index >>= 1)
+						++bit;
+
+					mX ^= mDirectionsX[bit % 32];
+					mY ^= mDirectionsY[bit % 32];
+					++mIndex;
+
+					// Float rounding may yield exactly 1
+					point.x = std::min(point.x, 0.99999994f);
+					point.y = std::min(point.y, 0.99999994f);
+					return point;
+				}
+
+			private:
+				unsigned int		mIndex;
+				sf::Uint32			mX;
+				sf::Uint32			mY;
+				sf::Uint32			mDirectionsX[32];
+				sf::Uint32			mDirectionsY[32];
+		};
+
+		// Creates a distribution that advances a low-discrepancy sequence (shared among copies) and maps it to a shape
+		template <typename Sequence, typename Fn>
+		Distribution<sf::Vector2f> sequenceDistribution(Fn mapping)
+		{
+			std::shared_ptr<Sequence> sequence = std::make_shared<Sequence>();
+
+			return [sequence, mapping] () -> sf::Vector2f
+			{
+				return mapping(sequence->next());
+			};
+		}
+
+		// Bridson's Poisson-disk sampling inside an arbitrary region, given by its bounding rect and a predicate
+		template <typename Fn>
+		std::vector<sf::Vector2f> poissonDisk(sf::Vector2f boundsMin, sf::Vector2f boundsMax, float minDistance, Fn contains)
+		{
+			assert(minDistance > 0.f);
+			assert(boundsMin.x <= boundsMax.x && boundsMin.y <= boundsMax.y);
+
+			// Number of candidates around an active point before it is retired
+			const unsigned int maxAttempts = 30;
+
+			// Background grid with cells small enough to contain at most one point
+			const float cellSize = minDistance / std::sqrt(2.f);
+			const int columns = static_cast<int>((boundsMax.x - boundsMin.x) / cellSize) + 1;
+			const int rows = static_cast<int>((boundsMax.y - boundsMin.y) / cellSize) + 1;
+			const std::size_t empty = static_cast<std::size_t>(-1);
+
+			std::vector<std::size_t> grid(static_cast<std::size_t>(columns) * rows, empty);
+			std::vector<sf::Vector2f> points;
+			std::vector<std::size_t> active;
+
+			auto cellOf = [&] (sf::Vector2f point) -> sf::Vector2i
+			{
+				return sf::Vector2i(
+					std::min(static_cast<int>((point.x - boundsMin.x) / cellSize), columns - 1),
+					std::min(static_cast<int>((point.y - boundsMin.y) / cellSize), rows - 1));
+			};
+
+			auto addPoint = [&] (sf::Vector2f point)
+			{
+				sf::Vector2i cell = cellOf(point);
+				grid[cell.y * columns + cell.x] = points.size();
+				active.push_back(points.size());
+				points.push_back(point);
+			};
+
+			auto isFree = [&] (sf::Vector2f point) -> bool
 			{
-				return random(min, max);
+				sf::Vector2i cell = cellOf(point);
+				for (int y = std::max(cell.y - 2, 0); y <= std::min(cell.y + 2, rows - 1); ++y)
+				{
+					for (int x = std::max(cell.x - 2, 0); x <= std::min(cell.x + 2, columns - 1); ++x)
+					{
+						std::size_t neighbor = grid[y * columns + x];
+						if (neighbor != empty && squaredLength(points[neighbor] - point) < minDistance * minDistance)
+							return false;
+					}
+				}
+
+				return true;
 			};
+
+			auto isInside = [&] (sf::Vector2f point) -> bool
+			{
+				return point.x >= boundsMin.x && point.x <= boundsMax.x
+					&& point.y >= boundsMin.y && point.y <= boundsMax.y
+					&& contains(point);
+			};
+
+			// Initial point: rejection sampling in the bounding rect
+			for (unsigned int attempt = 0; attempt < 100 * maxAttempts; ++attempt)
+			{
+				sf::Vector2f point(random(boundsMin.x, boundsMax.x), random(boundsMin.y, boundsMax.y));
+				if (contains(point))
+				{
+					addPoint(point);
+					break;
+				}
+			}
+
+			// Grow from active points: try candidates in the annulus [minDistance, 2*minDistance] around them
+			while (!active.empty())
+			{
+				std::size_t activeIndex = random(0u, static_cast<unsigned int>(active.size() - 1));
+				sf::Vector2f origin = points[active[activeIndex]];
+
+				bool found = false;
+				for (unsigned int attempt = 0; attempt < maxAttempts; ++attempt)
+				{
+					sf::Vector2f offset = PolarVector2f(random(minDistance, 2.f * minDistance), random(0.f, 360.f));
+					sf::Vector2f candidate = origin + offset;
+
+					if (isInside(candidate) && isFree(candidate))
+					{
+						addPoint(candidate);
+						found = true;
+						break;
+					}
+				}
+
+				// No space left around this point: retire it
+				if (!found)
+				{
+					active[activeIndex] = active.back();
+					active.pop_back();
+				}
+			}
+
+			return points;
 		}
 	}
 
@@ -69,38 +465,21 @@ namespace Distributions
 
 	Distribution<sf::Time> uniform(sf::Time min, sf::Time max)
 	{
-		assert(min <= max);
-
-		const float floatMin = min.asSeconds();
-		const float floatMax = max.asSeconds();
-
-		return [=] () -> sf::Time
-		{
-			return sf::seconds(random(floatMin, floatMax));
-		};
+		return uniformT(min, max);
 	}
 
 	Distribution<sf::Vector2f> rect(sf::Vector2f center, sf::Vector2f halfSize)
 	{
 		assert(halfSize.x >= 0.f && halfSize.y >= 0.f);
 
-		return [=] () -> sf::Vector2f
-		{
-			return sf::Vector2f(
-				randomDev(center.x, halfSize.x),
-				randomDev(center.y, halfSize.y));
-		};
+		return detail::makeBuiltinDistribution(detail::RectDistribution, center, halfSize);
 	}
 
 	Distribution<sf::Vector2f> circle(sf::Vector2f center, float radius)
 	{
 		assert(radius >= 0.f);
 
-		return [=] () -> sf::Vector2f
-		{
-			sf::Vector2f radiusVector = PolarVector2f(radius * std::sqrt(random(0.f, 1.f)), random(0.f, 360.f));
-			return center + radiusVector;
-		};
+		return detail::makeBuiltinDistribution(detail::CircleDistribution, center, sf::Vector2f(radius, 0.f));
 	}
 
 	Distribution<sf::Vector2f> deflect(sf::Vector2f direction, float maxRotation)
@@ -111,5 +490,117 @@ namespace Distributions
 		};
 	}
 
+	Distribution<sf::Vector2f> imageMask(const sf::Image& image, sf::Vector2f topLeft, sf::Uint8 alphaThreshold)
+	{
+		return pixelDistribution(image, topLeft, [=] (sf::Color color) -> double
+		{
+			return color.a > alphaThreshold ? 1.0 : 0.0;
+		});
+	}
+
+	Distribution<sf::Vector2f> imageBrightness(const sf::Image& image, sf::Vector2f topLeft)
+	{
+		return pixelDistribution(image, topLeft, [] (sf::Color color) -> double
+		{
+			// Rec. 601 luminance, multiplied by opacity
+			double luminance = 0.299 * color.r + 0.587 * color.g + 0.114 * color.b;
+			return luminance * color.a;
+		});
+	}
+
+	Distribution<sf::Vector2f> haltonRect(sf::Vector2f center, sf::Vector2f halfSize)
+	{
+		assert(halfSize.x >= 0.f && halfSize.y >= 0.f);
+
+		return sequenceDistribution<HaltonSequence>([=] (sf::Vector2f unit)
+		{
+			return mapToRect(unit, center, halfSize);
+		});
+	}
+
+	Distribution<sf::Vector2f> haltonCircle(sf::Vector2f center, float radius)
+	{
+		assert(radius >= 0.f);
+
+		return sequenceDistribution<HaltonSequence>([=] (sf::Vector2f unit)
+		{
+			return mapToCircle(unit, center, radius);
+		});
+	}
+
+	Distribution<sf::Vector2f> sobolRect(sf::Vector2f center, sf::Vector2f halfSize)
+	{
+		assert(halfSize.x >= 0.f && halfSize.y >= 0.f);
+
+		return sequenceDistribution<SobolSequence>([=] (sf::Vector2f unit)
+		{
+			return mapToRect(unit, center, halfSize);
+		});
+	}
+
+	Distribution<sf::Vector2f> sobolCircle(sf::Vector2f center, float radius)
+	{
+		assert(radius >= 0.f);
+
+		return sequenceDistribution<SobolSequence>([=] (sf::Vector2f unit)
+		{
+			return mapToCircle(unit, center, radius);
+		});
+	}
+
+	std::vector<sf::Vector2f> poissonDiskRect(sf::Vector2f center, sf::Vector2f halfSize, float minDistance)
+	{
+		assert(halfSize.x >= 0.f && halfSize.y >= 0.f);
+
+		return poissonDisk(center - halfSize, center + halfSize, minDistance, [] (sf::Vector2f)
+		{
+			return true;
+		});
+	}
+
+	std::vector<sf::Vector2f> poissonDiskCircle(sf::Vector2f center, float radius, float minDistance)
+	{
+		assert(radius >= 0.f);
+
+		const sf::Vector2f halfSize(radius, radius);
+		return poissonDisk(center - halfSize, center + halfSize, minDistance, [=] (sf::Vector2f point)
+		{
+			return squaredLength(point - center) <= radius * radius;
+		});
+	}
+
+	std::vector<sf::Vector2f> poissonDiskPolygon(const std::vector<sf::Vector2f>& polygon, float minDistance)
+	{
+		if (polygon.size() < 3)
+			return std::vector<sf::Vector2f>();
+
+		sf::Vector2f boundsMin = polygon.front();
+		sf::Vector2f boundsMax = polygon.front();
+		AURORA_FOREACH(sf::Vector2f corner, polygon)
+		{
+			boundsMin.x = std::min(boundsMin.x, corner.x);
+			boundsMin.y = std::min(boundsMin.y, corner.y);
+			boundsMax.x = std::max(boundsMax.x, corner.x);
+			boundsMax.y = std::max(boundsMax.y, corner.y);
+		}
+
+		// Even-odd rule: count crossings of a horizontal ray with the polygon edges
+		return poissonDisk(boundsMin, boundsMax, minDistance, [&polygon] (sf::Vector2f point) -> bool
+		{
+			bool inside = false;
+			for (std::size_t i = 0, j = polygon.size() - 1; i < polygon.size(); j = i++)
+			{
+				sf::Vector2f a = polygon[i];
+				sf::Vector2f b = polygon[j];
+
+				if ((a.y > point.y) != (b.y > point.y)
+				 && point.x < a.x + (b.x - a.x) * (point.y - a.y) / (b.y - a.y))
+					inside = !inside;
+			}
+
+			return inside;
+		});
+	}
+
 } // namespace Distributions
 } // namespace thor
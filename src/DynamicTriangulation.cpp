@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Math/DynamicTriangulation.hpp>
+
+#include <cassert>
+
+
+namespace thor
+{
+namespace
+{
+
+	// Returns the index in the triangulation data of the vertex with the given identifier
+	detail::TrIndex toDataIndex(const detail::TriangulationData& data, std::uint32_t vertex)
+	{
+		detail::TrIndex index = vertex + detail::BoundaryVertexCount;
+		assert(index < data.positions.size() && data.vertexEdges[index] != detail::InvalidTrIndex);
+
+		return index;
+	}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+DynamicTriangulation::DynamicTriangulation()
+: mData()
+, mFreeVertices()
+, mLastVertex(detail::InvalidTrIndex)
+{
+	clear();
+}
+
+std::uint32_t DynamicTriangulation::insertVertex(sf::Vector2f position)
+{
+	// Reuse the slot of a removed vertex, if there is one
+	detail::TrIndex vertex;
+	if (mFreeVertices.empty())
+	{
+		vertex = static_cast<detail::TrIndex>(mData.positions.size());
+		mData.positions.push_back(position);
+		mData.vertexEdges.push_back(detail::InvalidTrIndex);
+	}
+	else
+	{
+		vertex = mFreeVertices.back();
+		mFreeVertices.pop_back();
+		mData.positions[vertex] = position;
+	}
+
+	detail::insertDynamicVertex(mData, vertex, mLastVertex);
+	mLastVertex = vertex;
+
+	return vertex - detail::BoundaryVertexCount;
+}
+
+void DynamicTriangulation::removeVertex(std::uint32_t vertex)
+{
+	detail::TrIndex index = toDataIndex(mData, vertex);
+
+	detail::removeDynamicVertex(mData, index);
+	mFreeVertices.push_back(index);
+}
+
+void DynamicTriangulation::moveVertex(std::uint32_t vertex, sf::Vector2f position)
+{
+	detail::TrIndex index = toDataIndex(mData, vertex);
+
+	detail::moveDynamicVertex(mData, index, position);
+	mLastVertex = index;
+}
+
+sf::Vector2f DynamicTriangulation::getVertexPosition(std::uint32_t vertex) const
+{
+	return mData.positions[toDataIndex(mData, vertex)];
+}
+
+void DynamicTriangulation::insertConstrainedEdge(std::uint32_t start, std::uint32_t end)
+{
+	detail::insertDynamicEdge(mData, toDataIndex(mData, start), toDataIndex(mData, end));
+}
+
+void DynamicTriangulation::removeConstrainedEdge(std::uint32_t start, std::uint32_t end)
+{
+	detail::removeDynamicEdge(mData, toDataIndex(mData, start), toDataIndex(mData, end));
+}
+
+void DynamicTriangulation::clear()
+{
+	detail::resetTriangulation(mData);
+	detail::rebuildDynamicTriangulation(mData);
+
+	mFreeVertices.clear();
+	mLastVertex = detail::InvalidTrIndex;
+}
+
+} // namespace thor
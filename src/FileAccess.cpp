@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Resources/Detail/FileAccess.hpp>
+
+#include <limits>
+
+#if defined(_WIN32) || defined(__WIN32__)
+	#ifndef WIN32_LEAN_AND_MEAN
+		#define WIN32_LEAN_AND_MEAN
+	#endif
+	#ifndef NOMINMAX
+		#define NOMINMAX
+	#endif
+	#include <windows.h>
+	#include <sys/stat.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+
+namespace thor
+{
+namespace detail
+{
+
+	const char* mapFile(const std::string& filename, std::size_t& size)
+	{
+#if defined(_WIN32) || defined(__WIN32__)
+		HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER fileSize;
+		const char* mapping = nullptr;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+		 && static_cast<std::uint64_t>(fileSize.QuadPart) <= std::numeric_limits<std::size_t>::max())
+		{
+			// The view keeps the file mapping alive, so the handles can be closed right away
+			if (HANDLE fileMapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL))
+			{
+				mapping = static_cast<const char*>(MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0));
+				size = static_cast<std::size_t>(fileSize.QuadPart);
+				CloseHandle(fileMapping);
+			}
+		}
+
+		CloseHandle(file);
+		return mapping;
+#else
+		int file = open(filename.c_str(), O_RDONLY);
+		if (file == -1)
+			return nullptr;
+
+		struct stat status;
+		const char* mapping = nullptr;
+		if (fstat(file, &status) == 0 && status.st_size > 0
+		 && static_cast<std::uint64_t>(status.st_size) <= std::numeric_limits<std::size_t>::max())
+		{
+			// The mapping stays valid after the file is closed
+			void* address = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+			if (address != MAP_FAILED)
+			{
+				mapping = static_cast<const char*>(address);
+				size = static_cast<std::size_t>(status.st_size);
+			}
+		}
+
+		close(file);
+		return mapping;
+#endif
+	}
+
+	void unmapFile(const char* mapping, std::size_t size)
+	{
+#if defined(_WIN32) || defined(__WIN32__)
+		static_cast<void>(size);
+		UnmapViewOfFile(mapping);
+#else
+		munmap(const_cast<char*>(mapping), size);
+#endif
+	}
+
+	bool getFileStatus(const std::string& filename, std::uint64_t& size, std::int64_t& modificationTime)
+	{
+#if defined(_WIN32) || defined(__WIN32__)
+		struct _stat64 status;
+		if (_stat64(filename.c_str(), &status) != 0)
+			return false;
+#else
+		struct stat status;
+		if (stat(filename.c_str(), &status) != 0)
+			return false;
+#endif
+
+		size = static_cast<std::uint64_t>(status.st_size);
+		modificationTime = static_cast<std::int64_t>(status.st_mtime);
+		return true;
+	}
+
+} // namespace detail
+} // namespace thor
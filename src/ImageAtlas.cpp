@@ -0,0 +1,343 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Graphics/ImageAtlas.hpp>
+
+#include <Aurora/Tools/ForEach.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+
+namespace thor
+{
+namespace
+{
+
+	struct PackRect
+	{
+		unsigned int x;
+		unsigned int y;
+		unsigned int width;
+		unsigned int height;
+	};
+
+	// Image to pack, with its size including padding
+	struct PackItem
+	{
+		const std::string*	name;
+		const sf::Image*	image;
+		unsigned int		width;
+		unsigned int		height;
+	};
+
+	bool intersects(const PackRect& lhs, const PackRect& rhs)
+	{
+		return lhs.x < rhs.x + rhs.width && rhs.x < lhs.x + lhs.width
+			&& lhs.y < rhs.y + rhs.height && rhs.y < lhs.y + lhs.height;
+	}
+
+	bool contains(const PackRect& outer, const PackRect& inner)
+	{
+		return inner.x >= outer.x && inner.y >= outer.y
+			&& inner.x + inner.width <= outer.x + outer.width
+			&& inner.y + inner.height <= outer.y + outer.height;
+	}
+
+	// Rectangle packer, which keeps track of all maximal free rectangles (these may overlap each other)
+	class MaxRectsBin
+	{
+		public:
+			MaxRectsBin(unsigned int width, unsigned int height)
+			: mFree()
+			{
+				PackRect all = {0u, 0u, width, height};
+				mFree.push_back(all);
+			}
+
+			// Places a rectangle at the free position where it fits most tightly (best short side fit)
+			bool insert(unsigned int width, unsigned int height, PackRect& placed)
+			{
+				std::size_t best = mFree.size();
+				unsigned int bestShortSide = std::numeric_limits<unsigned int>::max();
+				unsigned int bestLongSide = std::numeric_limits<unsigned int>::max();
+
+				for (std::size_t i = 0; i < mFree.size(); ++i)
+				{
+					const PackRect& free = mFree[i];
+					if (free.width < width || free.height < height)
+						continue;
+
+					const unsigned int shortSide = std::min(free.width - width, free.height - height);
+					const unsigned int longSide = std::max(free.width - width, free.height - height);
+					if (shortSide < bestShortSide || (shortSide == bestShortSide && longSide < bestLongSide))
+					{
+						best = i;
+						bestShortSide = shortSide;
+						bestLongSide = longSide;
+					}
+				}
+
+				if (best == mFree.size())
+					return false;
+
+				placed.x = mFree[best].x;
+				placed.y = mFree[best].y;
+				placed.width = width;
+				placed.height = height;
+
+				split(placed);
+				prune();
+				return true;
+			}
+
+		private:
+			// Replaces every free rectangle that overlaps used by the up to 4 maximal rectangles around used
+			void split(const PackRect& used)
+			{
+				std::vector<PackRect> result;
+				result.reserve(mFree.size() + 4);
+
+				AURORA_FOREACH(const PackRect& free, mFree)
+				{
+					if (!intersects(free, used))
+					{
+						result.push_back(free);
+						continue;
+					}
+
+					if (used.x > free.x)
+					{
+						PackRect left = {free.x, free.y, used.x - free.x, free.height};
+						result.push_back(left);
+					}
+
+					if (used.x + used.width < free.x + free.width)
+					{
+						PackRect right = {used.x + used.width, free.y, free.x + free.width - used.x - used.width, free.height};
+						result.push_back(right);
+					}
+
+					if (used.y > free.y)
+					{
+						PackRect top = {free.x, free.y, free.width, used.y - free.y};
+						result.push_back(top);
+					}
+
+					if (used.y + used.height < free.y + free.height)
+					{
+						PackRect bottom = {free.x, used.y + used.height, free.width, free.y + free.height - used.y - used.height};
+						result.push_back(bottom);
+					}
+				}
+
+				mFree.swap(result);
+			}
+
+			// Removes free rectangles that are contained in another one (of two equal rectangles, the first is kept)
+			void prune()
+			{
+				std::vector<bool> redundant(mFree.size(), false);
+				for (std::size_t i = 0; i < mFree.size(); ++i)
+				{
+					for (std::size_t j = 0; j < mFree.size() && !redundant[i]; ++j)
+					{
+						if (i != j && !redundant[j] && contains(mFree[j], mFree[i]))
+							redundant[i] = true;
+					}
+				}
+
+				std::size_t kept = 0;
+				for (std::size_t i = 0; i < mFree.size(); ++i)
+				{
+					if (!redundant[i])
+						mFree[kept++] = mFree[i];
+				}
+
+				mFree.resize(kept);
+			}
+
+		private:
+			std::vector<PackRect>	mFree;
+	};
+
+	// Larger images first, since they are harder to place. Ties keep the order of the names.
+	bool isPackedBefore(const PackItem& lhs, const PackItem& rhs)
+	{
+		const unsigned int lhsLong = std::max(lhs.width, lhs.height);
+		const unsigned int rhsLong = std::max(rhs.width, rhs.height);
+		if (lhsLong != rhsLong)
+			return lhsLong > rhsLong;
+
+		return std::min(lhs.width, lhs.height) > std::min(rhs.width, rhs.height);
+	}
+
+	// Packs all items into a bin of the given size; the positions are stored in the order of items
+	bool packItems(const std::vector<PackItem>& items, unsigned int width, unsigned int height, std::vector<PackRect>& placed)
+	{
+		MaxRectsBin bin(width, height);
+		placed.resize(items.size());
+
+		for (std::size_t i = 0; i < items.size(); ++i)
+		{
+			if (!bin.insert(items[i].width, items[i].height, placed[i]))
+				return false;
+		}
+
+		return true;
+	}
+
+	unsigned int nextPowerOfTwo(unsigned int value)
+	{
+		unsigned int result = 1u;
+		while (result < value)
+			result *= 2u;
+
+		return result;
+	}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+ImageAtlas::ImageAtlas()
+: mImage()
+, mTextureRects()
+{
+}
+
+bool ImageAtlas::loadFromBuilder(const AtlasBuilder& builder)
+{
+	const unsigned int padding = builder.mPadding;
+	const sf::Vector2u maximalSize = builder.mMaximalSize;
+
+	// Load image files; reserve memory in advance, so that pointers to the images remain valid
+	std::vector<sf::Image> loaded;
+	loaded.reserve(builder.mEntries.size());
+
+	std::vector<PackItem> items;
+	items.reserve(builder.mEntries.size());
+
+	std::uint64_t area = 0;
+	AURORA_FOREACH(const auto& entry, builder.mEntries)
+	{
+		const sf::Image* image = entry.second.image.get();
+		if (!image)
+		{
+			loaded.push_back(sf::Image());
+			if (!loaded.back().loadFromFile(entry.second.filename))
+				return false;
+
+			image = &loaded.back();
+		}
+
+		const sf::Vector2u imageSize = image->getSize();
+		if (imageSize.x > maximalSize.x || imageSize.y > maximalSize.y)
+			return false;
+
+		// Padding is added to the right and bottom of each image; the bin is enlarged by padding, so that it is not needed at the border
+		PackItem item = {&entry.first, image, imageSize.x + padding, imageSize.y + padding};
+		items.push_back(item);
+		area += static_cast<std::uint64_t>(item.width) * item.height;
+	}
+
+	std::stable_sort(items.begin(), items.end(), &isPackedBefore);
+
+	// Start with the smallest power-of-two size that can hold the largest image and the total area, and grow until all images fit
+	sf::Vector2u size(1u, 1u);
+	AURORA_FOREACH(const PackItem& item, items)
+	{
+		size.x = std::max(size.x, std::min(nextPowerOfTwo(item.width - padding), maximalSize.x));
+		size.y = std::max(size.y, std::min(nextPowerOfTwo(item.height - padding), maximalSize.y));
+	}
+
+	std::vector<PackRect> placed;
+	for (;;)
+	{
+		const bool isMaximal = size.x == maximalSize.x && size.y == maximalSize.y;
+		const bool hasArea = static_cast<std::uint64_t>(size.x + padding) * (size.y + padding) >= area;
+
+		if (hasArea && packItems(items, size.x + padding, size.y + padding, placed))
+			break;
+
+		if (isMaximal)
+			return false;
+
+		// Grow the shorter side, or the one that may still grow
+		if ((size.x <= size.y && size.x < maximalSize.x) || size.y == maximalSize.y)
+			size.x = std::min(size.x * 2u, maximalSize.x);
+		else
+			size.y = std::min(size.y * 2u, maximalSize.y);
+	}
+
+	// Packing succeeded: nothing can fail from here on
+	sf::Vector2u bounds(0u, 0u);
+	AURORA_FOREACH(const PackRect& rect, placed)
+	{
+		bounds.x = std::max(bounds.x, rect.x + rect.width - padding);
+		bounds.y = std::max(bounds.y, rect.y + rect.height - padding);
+	}
+
+	mImage.create(bounds.x, bounds.y, sf::Color::Transparent);
+	mTextureRects.clear();
+
+	for (std::size_t i = 0; i < items.size(); ++i)
+	{
+		const sf::Vector2u imageSize = items[i].image->getSize();
+		mImage.copy(*items[i].image, placed[i].x, placed[i].y);
+		mTextureRects[*items[i].name] = sf::IntRect(placed[i].x, placed[i].y, imageSize.x, imageSize.y);
+	}
+
+	return true;
+}
+
+const sf::Image& ImageAtlas::getImage() const
+{
+	return mImage;
+}
+
+bool ImageAtlas::hasTextureRect(const std::string& name) const
+{
+	return mTextureRects.find(name) != mTextureRects.end();
+}
+
+sf::IntRect ImageAtlas::getTextureRect(const std::string& name) const
+{
+	auto found = mTextureRects.find(name);
+	assert(found != mTextureRects.end());
+
+	return found->second;
+}
+
+const std::map<std::string, sf::IntRect>& ImageAtlas::getTextureRects() const
+{
+	return mTextureRects;
+}
+
+} // namespace thor
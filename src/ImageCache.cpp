@@ -0,0 +1,187 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Resources/ImageCache.hpp>
+#include <Thor/Resources/Detail/FileAccess.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+
+namespace thor
+{
+namespace
+{
+
+	// File layout (all integers little endian):
+	//  header:  magic (8 bytes), version (uint32), width (uint32), height (uint32), filename length (uint32),
+	//           image file size (uint64), image file modification time (int64)
+	//  name:    filename of the image file, without terminator
+	//  pixels:  RGBA, row by row, at an offset that is a multiple of alignment
+	const char			magic[8] = {'T', 'h', 'o', 'r', 'I', 'm', 'g', 'C'};
+	const std::uint32_t	version = 1;
+	const std::size_t	headerSize = 40;
+	const std::size_t	alignment = 16;
+
+	std::size_t alignOffset(std::size_t offset)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	// Tries to load the image from an up-to-date cache file
+	bool readCache(sf::Image& image, const std::string& cacheFilename, const std::string& filename,
+		std::uint64_t fileSize, std::int64_t modificationTime)
+	{
+		std::size_t size;
+		const char* mapping = detail::mapFile(cacheFilename, size);
+		if (!mapping)
+			return false;
+
+		const std::size_t pixelOffset = alignOffset(headerSize + filename.size());
+		std::uint64_t width = 0;
+		std::uint64_t height = 0;
+
+		bool valid = size >= pixelOffset
+			&& std::memcmp(mapping, magic, sizeof(magic)) == 0
+			&& detail::readLittleEndian<std::uint32_t>(mapping + 8) == version
+			&& detail::readLittleEndian<std::uint32_t>(mapping + 20) == filename.size()
+			&& detail::readLittleEndian<std::uint64_t>(mapping + 24) == fileSize
+			&& static_cast<std::int64_t>(detail::readLittleEndian<std::uint64_t>(mapping + 32)) == modificationTime;
+
+		// Different image files may have the same cache filename, and the cache file must be complete
+		if (valid)
+		{
+			width = detail::readLittleEndian<std::uint32_t>(mapping + 12);
+			height = detail::readLittleEndian<std::uint32_t>(mapping + 16);
+
+			valid = size == pixelOffset + width * height * 4
+				&& filename.compare(0, filename.size(), mapping + headerSize, filename.size()) == 0;
+		}
+
+		if (valid)
+			image.create(static_cast<unsigned int>(width), static_cast<unsigned int>(height), reinterpret_cast<const sf::Uint8*>(mapping + pixelOffset));
+
+		detail::unmapFile(mapping, size);
+		return valid;
+	}
+
+	// Writes a cache file; failures are ignored, as the image has already been loaded
+	void writeCache(const sf::Image& image, const std::string& cacheFilename, const std::string& temporaryFilename,
+		const std::string& filename, std::uint64_t fileSize, std::int64_t modificationTime)
+	{
+		const sf::Vector2u imageSize = image.getSize();
+		if (imageSize.x == 0 || imageSize.y == 0)
+			return;
+
+		std::string head(magic, sizeof(magic));
+		detail::writeLittleEndian<std::uint32_t>(head, version);
+		detail::writeLittleEndian<std::uint32_t>(head, imageSize.x);
+		detail::writeLittleEndian<std::uint32_t>(head, imageSize.y);
+		detail::writeLittleEndian<std::uint32_t>(head, static_cast<std::uint32_t>(filename.size()));
+		detail::writeLittleEndian<std::uint64_t>(head, fileSize);
+		detail::writeLittleEndian<std::uint64_t>(head, static_cast<std::uint64_t>(modificationTime));
+		head += filename;
+		head.resize(alignOffset(head.size()), '\0');
+
+		// Write to a temporary file first, so that other threads or processes never see an incomplete cache file
+		{
+			std::ofstream file(temporaryFilename.c_str(), std::ios::binary | std::ios::trunc);
+			file.write(head.data(), head.size());
+			file.write(reinterpret_cast<const char*>(image.getPixelsPtr()), static_cast<std::size_t>(imageSize.x) * imageSize.y * 4);
+			file.close();
+
+			if (file.fail())
+			{
+				std::remove(temporaryFilename.c_str());
+				return;
+			}
+		}
+
+		// On Windows, rename() fails if the target exists
+		if (std::rename(temporaryFilename.c_str(), cacheFilename.c_str()) != 0)
+		{
+			std::remove(cacheFilename.c_str());
+			if (std::rename(temporaryFilename.c_str(), cacheFilename.c_str()) != 0)
+				std::remove(temporaryFilename.c_str());
+		}
+	}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+ImageCache::ImageCache(const std::string& directory)
+: mDirectory(directory)
+, mWriteCount(0)
+{
+	if (!mDirectory.empty() && mDirectory.back() != '/' && mDirectory.back() != '\\')
+		mDirectory += '/';
+}
+
+bool ImageCache::loadImage(sf::Image& image, const std::string& filename) const
+{
+	std::uint64_t fileSize;
+	std::int64_t modificationTime;
+	if (!detail::getFileStatus(filename, fileSize, modificationTime))
+		return false;
+
+	const std::string cacheFilename = getCacheFilename(filename);
+	if (readCache(image, cacheFilename, filename, fileSize, modificationTime))
+		return true;
+
+	if (!image.loadFromFile(filename))
+		return false;
+
+	// Temporary filename unique among the threads writing to the cache
+	const std::string temporaryFilename = cacheFilename + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+		+ "." + std::to_string(mWriteCount++) + ".tmp";
+
+	writeCache(image, cacheFilename, temporaryFilename, filename, fileSize, modificationTime);
+	return true;
+}
+
+std::string ImageCache::getCacheFilename(const std::string& filename) const
+{
+	// FNV-1a hash of the filename
+	std::uint64_t hash = 14695981039346656037ull;
+	for (std::size_t i = 0; i < filename.size(); ++i)
+	{
+		hash ^= static_cast<unsigned char>(filename[i]);
+		hash *= 1099511628211ull;
+	}
+
+	char buffer[17];
+	std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(hash));
+	return mDirectory + buffer + ".img";
+}
+
+} // namespace thor
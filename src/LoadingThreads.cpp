@@ -0,0 +1,120 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Resources/Detail/LoadingThreads.hpp>
+
+#include <Aurora/Tools/ForEach.hpp>
+
+#include <algorithm>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	namespace
+	{
+
+		// Heap order: the task with the highest priority, and among those the earliest one, is in front
+		bool runsAfter(const std::shared_ptr<LoadingTask>& lhs, const std::shared_ptr<LoadingTask>& rhs)
+		{
+			if (lhs->priority != rhs->priority)
+				return lhs->priority < rhs->priority;
+
+			return lhs->sequence > rhs->sequence;
+		}
+
+	} // namespace
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	LoadingThreads::LoadingThreads(unsigned int threadCount)
+	: mQueue()
+	, mThreads()
+	, mMutex()
+	, mCondition()
+	, mSequence(0)
+	, mStopped(false)
+	{
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		for (unsigned int i = 0; i < threadCount; ++i)
+			mThreads.push_back(std::thread(&LoadingThreads::work, this));
+	}
+
+	LoadingThreads::~LoadingThreads()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mStopped = true;
+		}
+
+		mCondition.notify_all();
+		AURORA_FOREACH(std::thread& thread, mThreads)
+			thread.join();
+	}
+
+	void LoadingThreads::push(std::shared_ptr<LoadingTask> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			task->sequence = mSequence++;
+			mQueue.push_back(std::move(task));
+			std::push_heap(mQueue.begin(), mQueue.end(), &runsAfter);
+		}
+
+		mCondition.notify_one();
+	}
+
+	void LoadingThreads::work()
+	{
+		for (;;)
+		{
+			std::shared_ptr<LoadingTask> task;
+
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				while (!mStopped && mQueue.empty())
+					mCondition.wait(lock);
+
+				if (mStopped)
+					return;
+
+				std::pop_heap(mQueue.begin(), mQueue.end(), &runsAfter);
+				task = std::move(mQueue.back());
+				mQueue.pop_back();
+			}
+
+			// Tasks that were cancelled or taken over by the owning thread are skipped
+			if (!task->claimed.exchange(true))
+				task->run();
+		}
+	}
+
+} // namespace detail
+} // namespace thor
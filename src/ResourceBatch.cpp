@@ -0,0 +1,235 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Resources/ResourceBatch.hpp>
+
+#include <condition_variable>
+#include <mutex>
+
+
+namespace thor
+{
+namespace detail
+{
+
+	// State shared by a ResourceBatch and the loading threads
+	struct BatchState
+	{
+		std::mutex					mutex;
+		std::condition_variable		condition;		// Notified when an item is prepared
+		std::vector<std::size_t>	prepared;		// Indices of items waiting to be finished on the owning thread
+	};
+
+} // namespace detail
+
+namespace
+{
+
+	// Runs the background phase of an item. The task refers weakly to the state and the item, which may have been discarded.
+	void prepareItem(const std::weak_ptr<detail::BatchState>& weakState, const std::weak_ptr<detail::BatchItem>& weakItem,
+		std::size_t index)
+	{
+		std::shared_ptr<detail::BatchState> state = weakState.lock();
+		std::shared_ptr<detail::BatchItem> item = weakItem.lock();
+		if (!state || !item)
+			return;
+
+		// An exception must not escape the loading thread: the item is reported without result, so that update() fails the batch
+		try
+		{
+			item->prepare();
+		}
+		catch (...)
+		{
+			item->discard();
+		}
+
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->prepared.push_back(index);
+		state->condition.notify_all();
+	}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+ResourceBatch::ResourceBatch()
+: mGroups()
+, mItems()
+, mState()
+, mProgressCallback()
+, mLoadedCount(0)
+, mLoadingThreadCount(0)
+, mStarted(false)
+, mCommitted(false)
+, mLoadingThreads()
+{
+}
+
+ResourceBatch::~ResourceBatch()
+{
+	abort();
+}
+
+void ResourceBatch::setProgressCallback(ProgressCallback callback)
+{
+	mProgressCallback = std::move(callback);
+}
+
+void ResourceBatch::setLoadingThreadCount(unsigned int threadCount)
+{
+	assert(!mStarted);
+	mLoadingThreadCount = threadCount;
+}
+
+void ResourceBatch::start()
+{
+	assert(!mStarted);
+
+	// Fail before anything is loaded, if possible
+	AURORA_FOREACH(const std::unique_ptr<detail::BatchGroup>& group, mGroups)
+		group->validate();
+
+	mStarted = true;
+	mState = std::make_shared<detail::BatchState>();
+	if (mItems.empty())
+		return;
+
+	mLoadingThreads = aurora::makeUnique<detail::LoadingThreads>(mLoadingThreadCount);
+	for (std::size_t i = 0; i < mItems.size(); ++i)
+	{
+		std::weak_ptr<detail::BatchState> weakState = mState;
+		std::weak_ptr<detail::BatchItem> weakItem = mItems[i];
+
+		mLoadingThreads->push(std::make_shared<detail::LoadingTask>(
+			[weakState, weakItem, i] () { prepareItem(weakState, weakItem, i); },
+			0));
+	}
+}
+
+bool ResourceBatch::update(std::size_t maxCount)
+{
+	assert(mStarted);
+	if (mCommitted)
+		return true;
+
+	for (std::size_t count = 0; count < maxCount && mLoadedCount < mItems.size(); ++count)
+	{
+		std::size_t index = 0;
+
+		{
+			std::lock_guard<std::mutex> lock(mState->mutex);
+			if (mState->prepared.empty())
+				break;
+
+			index = mState->prepared.front();
+			mState->prepared.erase(mState->prepared.begin());
+		}
+
+		if (!mItems[index]->finish())
+		{
+			const std::string info = mItems[index]->getInfo();
+			abort();
+
+			throw ResourceLoadingException("Failed to load resource \"" + info + "\"");
+		}
+
+		++mLoadedCount;
+		if (mProgressCallback)
+			mProgressCallback(mLoadedCount, mItems.size());
+	}
+
+	if (mLoadedCount < mItems.size())
+		return false;
+
+	mLoadingThreads.reset();
+
+	// Commit all or nothing: the holders may have changed since start()
+	try
+	{
+		AURORA_FOREACH(const std::unique_ptr<detail::BatchGroup>& group, mGroups)
+			group->validate();
+	}
+	catch (...)
+	{
+		abort();
+		throw;
+	}
+
+	AURORA_FOREACH(const std::unique_ptr<detail::BatchGroup>& group, mGroups)
+		group->commit();
+
+	mCommitted = true;
+	return true;
+}
+
+void ResourceBatch::load()
+{
+	start();
+
+	while (!update())
+		wait();
+}
+
+std::size_t ResourceBatch::getLoadedCount() const
+{
+	return mLoadedCount;
+}
+
+std::size_t ResourceBatch::getTotalCount() const
+{
+	return mItems.size();
+}
+
+void ResourceBatch::clear()
+{
+	abort();
+
+	mGroups.clear();
+	mItems.clear();
+	mState.reset();
+	mLoadedCount = 0;
+	mStarted = false;
+	mCommitted = false;
+}
+
+void ResourceBatch::abort()
+{
+	// Wait for items being prepared; the others are not started
+	mLoadingThreads.reset();
+
+	AURORA_FOREACH(const std::shared_ptr<detail::BatchItem>& item, mItems)
+		item->discard();
+}
+
+void ResourceBatch::wait()
+{
+	std::unique_lock<std::mutex> lock(mState->mutex);
+	while (mState->prepared.empty())
+		mState->condition.wait(lock);
+}
+
+} // namespace thor
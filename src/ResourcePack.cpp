@@ -0,0 +1,268 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Resources/ResourcePack.hpp>
+#include <Thor/Resources/Detail/FileAccess.hpp>
+
+#include <Aurora/Tools/ForEach.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+
+namespace thor
+{
+namespace
+{
+
+	// File layout (all integers little endian):
+	//  header:  magic (8 bytes), version (uint32), entry count (uint32)
+	//  index:   per entry: data offset (uint64), data size (uint64), name offset (uint32), name length (uint32); sorted by name
+	//  names:   name characters, without terminators; name offsets are relative to the begin of this block
+	//  data:    entry contents, each one at an offset that is a multiple of alignment
+	const char			magic[8] = {'T', 'h', 'o', 'r', 'P', 'a', 'c', 'k'};
+	const std::uint32_t	version = 1;
+	const std::size_t	headerSize = 16;
+	const std::size_t	indexEntrySize = 24;
+	const std::size_t	alignment = 16;
+
+	std::uint64_t alignOffset(std::uint64_t offset)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	// Byte-wise comparison, consistent with the order of std::string
+	int compareNames(const char* lhs, std::size_t lhsLength, const char* rhs, std::size_t rhsLength)
+	{
+		if (int result = std::memcmp(lhs, rhs, std::min(lhsLength, rhsLength)))
+			return result;
+
+		return (lhsLength < rhsLength) ? -1 : (lhsLength > rhsLength) ? 1 : 0;
+	}
+
+	// Returns whether [offset, offset+size[ lies within [0, total[
+	bool isInRange(std::uint64_t offset, std::uint64_t size, std::size_t total)
+	{
+		return offset <= total && size <= total - offset;
+	}
+
+	// Writes the pack file; called by ResourcePack::create() which removes the file on failure
+	bool writePack(const std::string& packFilename, std::vector<std::string> filenames)
+	{
+		std::sort(filenames.begin(), filenames.end());
+		if (std::adjacent_find(filenames.begin(), filenames.end()) != filenames.end())
+			return false;
+
+		// Determine file sizes, so that the index can be written before the contents
+		std::vector<std::uint64_t> sizes;
+		AURORA_FOREACH(const std::string& filename, filenames)
+		{
+			std::ifstream file(filename.c_str(), std::ios::binary | std::ios::ate);
+			if (!file)
+				return false;
+
+			sizes.push_back(static_cast<std::uint64_t>(file.tellg()));
+		}
+
+		// Header, index and names
+		std::string head(magic, sizeof(magic));
+		detail::writeLittleEndian<std::uint32_t>(head, version);
+		detail::writeLittleEndian<std::uint32_t>(head, static_cast<std::uint32_t>(filenames.size()));
+
+		std::uint64_t namesSize = 0;
+		AURORA_FOREACH(const std::string& filename, filenames)
+			namesSize += filename.size();
+
+		if (filenames.size() > std::numeric_limits<std::uint32_t>::max() || namesSize > std::numeric_limits<std::uint32_t>::max())
+			return false;
+
+		std::uint64_t dataOffset = alignOffset(headerSize + indexEntrySize * filenames.size() + namesSize);
+		std::uint32_t nameOffset = 0;
+		for (std::size_t i = 0; i < filenames.size(); ++i)
+		{
+			detail::writeLittleEndian<std::uint64_t>(head, dataOffset);
+			detail::writeLittleEndian<std::uint64_t>(head, sizes[i]);
+			detail::writeLittleEndian<std::uint32_t>(head, nameOffset);
+			detail::writeLittleEndian<std::uint32_t>(head, static_cast<std::uint32_t>(filenames[i].size()));
+
+			dataOffset = alignOffset(dataOffset + sizes[i]);
+			nameOffset += static_cast<std::uint32_t>(filenames[i].size());
+		}
+
+		AURORA_FOREACH(const std::string& filename, filenames)
+			head += filename;
+
+		std::ofstream pack(packFilename.c_str(), std::ios::binary | std::ios::trunc);
+		pack.write(head.data(), head.size());
+
+		// Contents, each one padded to the alignment
+		std::vector<char> buffer(64 * 1024);
+		std::uint64_t written = head.size();
+		for (std::size_t i = 0; i < filenames.size(); ++i)
+		{
+			const std::string padding(static_cast<std::size_t>(alignOffset(written) - written), '\0');
+			pack.write(padding.data(), padding.size());
+			written += padding.size();
+
+			std::ifstream file(filenames[i].c_str(), std::ios::binary);
+			std::uint64_t remaining = sizes[i];
+			while (remaining > 0)
+			{
+				const std::size_t chunk = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, buffer.size()));
+				if (!file.read(buffer.data(), chunk))
+					return false;
+
+				pack.write(buffer.data(), chunk);
+				remaining -= chunk;
+			}
+
+			written += sizes[i];
+		}
+
+		pack.close();
+		return !pack.fail();
+	}
+
+} // namespace
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+bool ResourcePack::create(const std::string& packFilename, const std::vector<std::string>& filenames)
+{
+	if (writePack(packFilename, filenames))
+		return true;
+
+	std::remove(packFilename.c_str());
+	return false;
+}
+
+ResourcePack::ResourcePack()
+: mMapping(nullptr)
+, mMappingSize(0)
+, mEntries()
+{
+}
+
+ResourcePack::~ResourcePack()
+{
+	close();
+}
+
+bool ResourcePack::openFromFile(const std::string& filename)
+{
+	close();
+
+	mMapping = detail::mapFile(filename, mMappingSize);
+	if (!mMapping)
+		return false;
+
+	if (readIndex())
+		return true;
+
+	close();
+	return false;
+}
+
+void ResourcePack::close()
+{
+	if (mMapping)
+		detail::unmapFile(mMapping, mMappingSize);
+
+	mMapping = nullptr;
+	mMappingSize = 0;
+	mEntries.clear();
+}
+
+bool ResourcePack::findEntry(const std::string& name, const void*& data, std::size_t& size) const
+{
+	auto itr = std::lower_bound(mEntries.begin(), mEntries.end(), name, [] (const Entry& entry, const std::string& name)
+	{
+		return compareNames(entry.name, entry.nameLength, name.data(), name.size()) < 0;
+	});
+
+	if (itr == mEntries.end() || compareNames(itr->name, itr->nameLength, name.data(), name.size()) != 0)
+		return false;
+
+	data = itr->data;
+	size = itr->size;
+	return true;
+}
+
+std::size_t ResourcePack::getEntryCount() const
+{
+	return mEntries.size();
+}
+
+std::string ResourcePack::getEntryName(std::size_t index) const
+{
+	return std::string(mEntries[index].name, mEntries[index].nameLength);
+}
+
+bool ResourcePack::readIndex()
+{
+	if (mMappingSize < headerSize || std::memcmp(mMapping, magic, sizeof(magic)) != 0
+	 || detail::readLittleEndian<std::uint32_t>(mMapping + 8) != version)
+		return false;
+
+	const std::uint64_t count = detail::readLittleEndian<std::uint32_t>(mMapping + 12);
+	if (!isInRange(headerSize, count * indexEntrySize, mMappingSize))
+		return false;
+
+	const std::size_t namesOffset = headerSize + static_cast<std::size_t>(count) * indexEntrySize;
+	mEntries.reserve(static_cast<std::size_t>(count));
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const char* indexEntry = mMapping + headerSize + i * indexEntrySize;
+		const std::uint64_t dataOffset = detail::readLittleEndian<std::uint64_t>(indexEntry);
+		const std::uint64_t dataSize = detail::readLittleEndian<std::uint64_t>(indexEntry + 8);
+		const std::uint64_t nameOffset = namesOffset + static_cast<std::uint64_t>(detail::readLittleEndian<std::uint32_t>(indexEntry + 16));
+		const std::uint32_t nameLength = detail::readLittleEndian<std::uint32_t>(indexEntry + 20);
+
+		if (!isInRange(dataOffset, dataSize, mMappingSize) || !isInRange(nameOffset, nameLength, mMappingSize))
+			return false;
+
+		Entry entry;
+		entry.name = mMapping + nameOffset;
+		entry.nameLength = nameLength;
+		entry.data = mMapping + dataOffset;
+		entry.size = static_cast<std::size_t>(dataSize);
+
+		// Binary search requires strictly increasing names
+		if (!mEntries.empty() && compareNames(mEntries.back().name, mEntries.back().nameLength, entry.name, entry.nameLength) >= 0)
+			return false;
+
+		mEntries.push_back(entry);
+	}
+
+	return true;
+}
+
+} // namespace thor
@@ -0,0 +1,60 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Math/StreamingTriangulation.hpp>
+
+#include <cassert>
+
+
+namespace thor
+{
+
+StreamingTriangulation::StreamingTriangulation(sf::Vector2f boundsMin, sf::Vector2f boundsMax, unsigned int columns, unsigned int rows)
+: mData()
+{
+	detail::EdgeBox bounds;
+	bounds.min = boundsMin;
+	bounds.max = boundsMax;
+
+	detail::resetStreamingTriangulation(mData, bounds, columns, rows);
+}
+
+std::uint32_t StreamingTriangulation::insertVertex(sf::Vector2f position)
+{
+	return detail::insertStreamingVertex(mData, position);
+}
+
+sf::Vector2u StreamingTriangulation::getCell(sf::Vector2f position) const
+{
+	detail::TrIndex cell = detail::getStreamingCell(mData, position);
+	return sf::Vector2u(cell % mData.columns, cell / mData.columns);
+}
+
+std::size_t StreamingTriangulation::getActiveTriangleCount() const
+{
+	return mData.mesh.firstVertices.size();
+}
+
+} // namespace thor
@@ -27,10 +27,11 @@
 #include <Thor/Vectors/VectorAlgebra2D.hpp>
 #include <Thor/Config.hpp>
 
-#include <functional>
-#include <numeric>
 #include <limits>
-#include <stack>
+#include <random>
+#include <cmath>
+#include <atomic>
+#include <thread>
 
 
 namespace thor
@@ -43,217 +44,321 @@ namespace
 namespace detail
 {
 
-	// Struct instead of typedef, since the latter cannot be forward-declared
-	struct OptTriangleItrArray
+	// Circle described by midpoint and squared radius
+	struct Circle
 	{
-		std::array<OptTriangleIterator, 3>	iterators;
-	};
-
-	// Type definitions
-	typedef std::array<TriangleIterator, 3>					TriangleItrArray;
-	typedef std::pair<TriangleIterator, TriangleIterator>	TriangleItrPair;
-	typedef std::pair<std::size_t, std::size_t>				IndexPair;
-
-	// ---------------------------------------------------------------------------------------------------------------------------
-
-
-	// Functor operator() definitions
-	bool CompareVertexPtrs::operator() (const AdvancedVertex* lhs, const AdvancedVertex* rhs) const
-	{
-		return std::make_pair(lhs->getPosition().x, lhs->getPosition().y)
-			<  std::make_pair(rhs->getPosition().x, rhs->getPosition().y);
-	}
+		Circle(sf::Vector2f midPoint, float squaredRadius)
+		: midPoint(midPoint)
+		, squaredRadius(squaredRadius)
+		{
+		}
 
-	bool CompareEdges::operator() (const AdvancedEdge& lhs, const AdvancedEdge& rhs) const
-	{
-		// Automatically compare each coordinate, delegate work to std::pair
-		return std::make_pair(
-			std::make_pair(lhs[0].getPosition().x, lhs[0].getPosition().y),
-			std::make_pair(lhs[1].getPosition().x, lhs[1].getPosition().y))
-		< std::make_pair(
-			std::make_pair(rhs[0].getPosition().x, rhs[0].getPosition().y),
-			std::make_pair(rhs[1].getPosition().x, rhs[1].getPosition().y));
-	}
+		sf::Vector2f	midPoint;
+		float			squaredRadius;
+	};
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 
 
-	OptTriangleIterator::OptTriangleIterator()
-	: valid(false)
-	, target()
+	// Returns the half-edge that follows e in the same triangle.
+	TrIndex nextHalfEdge(TrIndex e)
 	{
+		return (e % 3 == 2) ? e - 2 : e + 1;
 	}
 
-	OptTriangleIterator::OptTriangleIterator(TriangleIterator target)
-	: valid(true)
-	, target(target)
+	// Returns the half-edge that precedes e in the same triangle.
+	TrIndex previousHalfEdge(TrIndex e)
 	{
+		return (e % 3 == 0) ? e + 2 : e - 1;
 	}
 
-	OptTriangleIterator::OptTriangleIterator(const OptTriangleIterator& origin)
-	: valid(origin.valid)
-	, target()
+	// Returns the position of the vertex with the given index.
+	sf::Vector2f at(const TriangulationData& data, TrIndex vertex)
 	{
-		// Don't copy target if invalid, since the iterator is singular (default-constructed)
-		// and almost all operations on singular iterators evoke undefined behavior.
-		if (valid)
-			target = origin.target;
+		return data.positions[vertex];
 	}
 
-	OptTriangleIterator& OptTriangleIterator::operator= (const OptTriangleIterator& origin)
+	// Returns true if the vertex is one of the boundary (dummy) vertices.
+	bool isBoundary(TrIndex vertex)
 	{
-		// Don't assign target if invalid, since the iterator is singular (default-constructed)
-		// and almost all operations on singular iterators evoke undefined behavior.
-		valid = origin.valid;
-		if (valid)
-			target = origin.target;
-
-		return *this;
+		return vertex < BoundaryVertexCount;
 	}
 
 	// ---------------------------------------------------------------------------------------------------------------------------
 
 
-	Circle::Circle(sf::Vector2f midPoint, float squaredRadius)
-	: midPoint(midPoint)
-	, squaredRadius(squaredRadius)
-	{
-	}
-
-	// ---------------------------------------------------------------------------------------------------------------------------
+	// Exact arithmetic for the geometric predicates, following J. R. Shewchuk: "Adaptive Precision Floating-Point Arithmetic and
+	// Fast Robust Geometric Predicates". A number is represented as expansion, i.e. an array of doubles with non-overlapping bits,
+	// ordered by increasing magnitude. The largest (last) component determines the sign. Zero components are eliminated.
+	// The functions assume IEEE 754 double precision with round-to-nearest, they must not be compiled with unsafe math optimizations.
 
+	// Maximal number of components that occur during the exact in-circle test, in total and per factor of a product
+	const int MaxExpansionSize = 1536;
+	const int MaxFactorSize = 16;
 
-	AdvancedVertex::AdvancedVertex(float x, float y)
-	: mUserVertex(nullptr)
-	, mPosition(x, y)
-	, mSurroundingTriangle(aurora::makeCopied<OptTriangleIterator>())
-#ifndef NDEBUG
-	, mUserType(&typeid(void))
-#endif
+	// Computes x + y = a + b exactly, where x is the rounded sum.
+	void twoSum(double a, double b, double& x, double& y)
 	{
-		// mSurroundingTriangle is a singular iterator. setSurroundingTriangle() must called before other operations,
-		// especially before assignments and copies of AdvancedVertex objects.
-		// Can't initialize surroundingTriangle here: In case of boundary vertices, the vertices themselves form the triangle.
+		x = a + b;
+		double bVirtual = x - a;
+		double aVirtual = x - bVirtual;
+		y = (a - aVirtual) + (b - bVirtual);
 	}
 
-	sf::Vector2f AdvancedVertex::getPosition() const
+	// Splits a into two halves with 26 significant bits each, so that a = high + low.
+	void splitDouble(double a, double& high, double& low)
 	{
-		return mPosition;
+		const double splitter = 134217729.0; // 2^27 + 1
+		double c = splitter * a;
+		high = c - (c - a);
+		low = a - high;
 	}
 
-	void AdvancedVertex::setSurroundingTriangle(OptTriangleIterator target)
+	// Computes x + y = a * b exactly, where x is the rounded product.
+	void twoProduct(double a, double b, double& x, double& y)
 	{
-		assert(target.valid);
-		*mSurroundingTriangle = target;
+		x = a * b;
+
+		double aHigh, aLow, bHigh, bLow;
+		splitDouble(a, aHigh, aLow);
+		splitDouble(b, bHigh, bLow);
+		y = aLow * bLow - (((x - aHigh * bHigh) - aLow * bHigh) - aHigh * bLow);
 	}
 
-	OptTriangleIterator AdvancedVertex::getSurroundingTriangle() const
+	// Computes the expansion h = e + b and returns its size. h may be the same array as e.
+	int growExpansion(const double* e, int eSize, double b, double* h)
 	{
-		assert(mSurroundingTriangle->valid);
-		return *mSurroundingTriangle;
-	}
+		double q = b;
+		int hSize = 0;
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+		for (int i = 0; i < eSize; ++i)
+		{
+			double sum, error;
+			twoSum(q, e[i], sum, error);
+			q = sum;
+
+			if (error != 0.0)
+				h[hSize++] = error;
+		}
 
+		if (q != 0.0 || hSize == 0)
+			h[hSize++] = q;
 
-	AdvancedEdge::AdvancedEdge(AdvancedVertex& startPoint, AdvancedVertex& endPoint)
-	: Edge<AdvancedVertex>(startPoint, endPoint)
+		return hSize;
+	}
+
+	// Adds the expansion f to the expansion h in place and returns the new size of h.
+	int addExpansion(double* h, int hSize, const double* f, int fSize)
 	{
-		orderCorners();
+		for (int i = 0; i < fSize; ++i)
+			hSize = growExpansion(h, hSize, f[i], h);
+
+		assert(hSize <= MaxExpansionSize);
+		return hSize;
 	}
 
-	void AdvancedEdge::orderCorners()
+	// Computes the expansion h = e * b and returns its size. h must not overlap with e.
+	int scaleExpansion(const double* e, int eSize, double b, double* h)
 	{
-		if (CompareVertexPtrs()(mCorners[1], mCorners[0]))
+		double q, error;
+		int hSize = 0;
+
+		twoProduct(e[0], b, q, error);
+		if (error != 0.0)
+			h[hSize++] = error;
+
+		for (int i = 1; i < eSize; ++i)
 		{
-			std::swap(mCorners[0], mCorners[1]);
-		}
-	}
+			double product, productError, sum;
+			twoProduct(e[i], b, product, productError);
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+			twoSum(q, productError, sum, error);
+			if (error != 0.0)
+				h[hSize++] = error;
 
+			twoSum(product, sum, q, error);
+			if (error != 0.0)
+				h[hSize++] = error;
+		}
 
-	AdvancedTriangle::AdvancedTriangle(AdvancedVertex& corner0, AdvancedVertex& corner1, AdvancedVertex& corner2)
-	: Triangle<AdvancedVertex>(corner0, corner1, corner2)
-	, mRemainingVertices()
-	, mAdjacentTriangles(aurora::makeCopied<OptTriangleItrArray>())
-	, mFlagged(false)
-	{
-	}
+		if (q != 0.0 || hSize == 0)
+			h[hSize++] = q;
 
-	void AdvancedTriangle::addVertex(AdvancedVertex& vertexRef)
-	{
-		mRemainingVertices.insert(&vertexRef);
+		return hSize;
 	}
 
-	void AdvancedTriangle::removeVertex(AdvancedVertex& vertexRef)
+	// Computes the expansion h = e * f and returns its size. h must not overlap with e or f.
+	int multiplyExpansions(const double* e, int eSize, const double* f, int fSize, double* h)
 	{
-		std::size_t erased = mRemainingVertices.erase(&vertexRef);
-		assert(erased == 1);
+		assert(eSize <= MaxFactorSize);
+
+		double scaled[2 * MaxFactorSize];
+		int hSize = 1;
+		h[0] = 0.0;
+
+		for (int i = 0; i < fSize; ++i)
+		{
+			int scaledSize = scaleExpansion(e, eSize, f[i], scaled);
+			hSize = addExpansion(h, hSize, scaled, scaledSize);
+		}
+
+		return hSize;
 	}
 
-	void AdvancedTriangle::removeVertex(VertexPtrIterator vertexItr)
+	// Computes the expansion h = a - b and returns its size.
+	int subtractExactly(double a, double b, double* h)
 	{
-		std::size_t size = mRemainingVertices.size();
-		mRemainingVertices.erase(vertexItr);
-		assert(size == mRemainingVertices.size() + 1);
+		double difference, error;
+		twoSum(a, -b, difference, error);
+		return growExpansion(&error, 1, difference, h);
 	}
 
-	VertexPtrIterator AdvancedTriangle::begin()
+	// Returns the sign of the largest component of an expansion, which is the sign of the represented number.
+	int getExpansionSign(const double* e, int eSize)
 	{
-		return mRemainingVertices.begin();
+		return (e[eSize-1] > 0.0) - (e[eSize-1] < 0.0);
 	}
 
-	VertexPtrIterator AdvancedTriangle::end()
+	// Returns the sign of crossProduct(v1 - v0, v2 - v0), evaluated without rounding errors.
+	int computeExactOrientation(sf::Vector2f v0, sf::Vector2f v1, sf::Vector2f v2)
 	{
-		return mRemainingVertices.end();
+		// The product of two floats is exact in double precision. Expanded, the terms v0.x * v0.y cancel out.
+		const double products[6] =
+		{
+			 double(v1.x) * v2.y,
+			-double(v1.x) * v0.y,
+			-double(v0.x) * v2.y,
+			-double(v1.y) * v2.x,
+			 double(v1.y) * v0.x,
+			 double(v0.y) * v2.x,
+		};
+
+		double sum[7] = { 0.0 };
+		int sumSize = addExpansion(sum, 1, products, 6);
+		return getExpansionSign(sum, sumSize);
 	}
 
-	void AdvancedTriangle::setAdjacentTriangle(std::size_t index, const OptTriangleIterator& adjacentTriangle)
+	// Computes the expansion (ax^2 + ay^2) * (bx * cy - by * cx), one of the three terms of the in-circle determinant.
+	int computeExactLiftedTerm(
+		const double* ax, int axSize, const double* ay, int aySize,
+		const double* bx, int bxSize, const double* by, int bySize,
+		const double* cx, int cxSize, const double* cy, int cySize, double* h)
 	{
-		mAdjacentTriangles->iterators[index] = adjacentTriangle;
+		double lift[16], cross[16], product[8];
+
+		int liftSize = multiplyExpansions(ax, axSize, ax, axSize, lift);
+		int productSize = multiplyExpansions(ay, aySize, ay, aySize, product);
+		liftSize = addExpansion(lift, liftSize, product, productSize);
+
+		int crossSize = multiplyExpansions(bx, bxSize, cy, cySize, cross);
+		productSize = multiplyExpansions(by, bySize, cx, cxSize, product);
+		for (int i = 0; i < productSize; ++i)
+			product[i] = -product[i];
+		crossSize = addExpansion(cross, crossSize, product, productSize);
+
+		return multiplyExpansions(lift, liftSize, cross, crossSize, h);
 	}
 
-	OptTriangleIterator AdvancedTriangle::getAdjacentTriangle(std::size_t index) const
+	// Returns the sign of the in-circle determinant of a, b, c, d, evaluated without rounding errors. The determinant has the
+	// sign of crossProduct(b - a, c - a) if d is inside the circle through a, b, c, the opposite sign if it is outside.
+	int computeExactInCircle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d)
 	{
-		return mAdjacentTriangles->iterators[index];
+		// Differences of floats need not be exact in double precision (if the exponents differ a lot), so they are expansions too
+		double adx[2], ady[2], bdx[2], bdy[2], cdx[2], cdy[2];
+		int adxSize = subtractExactly(a.x, d.x, adx);
+		int adySize = subtractExactly(a.y, d.y, ady);
+		int bdxSize = subtractExactly(b.x, d.x, bdx);
+		int bdySize = subtractExactly(b.y, d.y, bdy);
+		int cdxSize = subtractExactly(c.x, d.x, cdx);
+		int cdySize = subtractExactly(c.y, d.y, cdy);
+
+		double determinant[MaxExpansionSize];
+		double term[MaxExpansionSize / 3];
+
+		int determinantSize = computeExactLiftedTerm(adx, adxSize, ady, adySize, bdx, bdxSize, bdy, bdySize, cdx, cdxSize, cdy, cdySize, determinant);
+		int termSize = computeExactLiftedTerm(bdx, bdxSize, bdy, bdySize, cdx, cdxSize, cdy, cdySize, adx, adxSize, ady, adySize, term);
+		determinantSize = addExpansion(determinant, determinantSize, term, termSize);
+		termSize = computeExactLiftedTerm(cdx, cdxSize, cdy, cdySize, adx, adxSize, ady, adySize, bdx, bdxSize, bdy, bdySize, term);
+		determinantSize = addExpansion(determinant, determinantSize, term, termSize);
+
+		return getExpansionSign(determinant, determinantSize);
 	}
 
-	void AdvancedTriangle::setFlagged(bool flagged)
+	// Returns the sign of crossProduct(v1 - v0, v2 - v0): positive, negative or zero if v2 is on the line v0-v1.
+	// Single precision decides almost all cases, the exact computation is only used if the rounding error might change the sign.
+	// The error bound does not hold for products in the subnormal range, those are computed exactly as well.
+	int computeOrientation(sf::Vector2f v0, sf::Vector2f v1, sf::Vector2f v2)
 	{
-		mFlagged = flagged;
+		const float epsilon = std::numeric_limits<float>::epsilon() / 2.f;
+		const float errorBound = (3.f + 16.f * epsilon) * epsilon;
+		const float minMagnitude = std::numeric_limits<float>::min() / epsilon;
+
+		float left = (v1.x - v0.x) * (v2.y - v0.y);
+		float right = (v1.y - v0.y) * (v2.x - v0.x);
+		float determinant = left - right;
+		float magnitude = std::abs(left) + std::abs(right);
+
+		if (std::abs(determinant) > errorBound * magnitude && magnitude > minMagnitude)
+			return (determinant > 0.f) - (determinant < 0.f);
+
+		return computeExactOrientation(v0, v1, v2);
 	}
 
-	bool AdvancedTriangle::isFlagged() const
+	// Returns true if point is strictly inside the circumcircle of the triangle (corner0,corner1,corner2), independent of its
+	// orientation. A flat triangle has an infinitely large circumcircle, which contains every point.
+	bool isInsideCircumcircle(sf::Vector2f corner0, sf::Vector2f corner1, sf::Vector2f corner2, sf::Vector2f point)
 	{
-		return mFlagged;
-	}
+		const int orientation = computeOrientation(corner0, corner1, corner2);
+		if (orientation == 0)
+			return true;
 
-	// ---------------------------------------------------------------------------------------------------------------------------
+		const double epsilon = std::numeric_limits<double>::epsilon() / 2.0;
+		const double errorBound = (10.0 + 96.0 * epsilon) * epsilon;
 
+		double adx = double(corner0.x) - point.x;
+		double ady = double(corner0.y) - point.y;
+		double bdx = double(corner1.x) - point.x;
+		double bdy = double(corner1.y) - point.y;
+		double cdx = double(corner2.x) - point.x;
+		double cdy = double(corner2.y) - point.y;
 
-	// Returns the position of the triangle's vertex identified by index.
-	sf::Vector2f at(const AdvancedTriangle& triangle, std::size_t index)
-	{
-		return triangle[index].getPosition();
+		double aLift = adx * adx + ady * ady;
+		double bLift = bdx * bdx + bdy * bdy;
+		double cLift = cdx * cdx + cdy * cdy;
+
+		double determinant = aLift * (bdx * cdy - cdx * bdy) + bLift * (cdx * ady - adx * cdy) + cLift * (adx * bdy - bdx * ady);
+		double permanent = aLift * (std::abs(bdx * cdy) + std::abs(cdx * bdy))
+			+ bLift * (std::abs(cdx * ady) + std::abs(adx * cdy))
+			+ cLift * (std::abs(adx * bdy) + std::abs(bdx * ady));
+
+		int sign;
+		if (std::abs(determinant) > errorBound * permanent)
+			sign = (determinant > 0.0) - (determinant < 0.0);
+		else
+			sign = computeExactInCircle(corner0, corner1, corner2, point);
+
+		return sign == orientation;
 	}
 
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
 	bool isClockwiseOriented(sf::Vector2f v0, sf::Vector2f v1, sf::Vector2f v2)
 	{
-		return crossProduct(v1 - v0, v2 - v0) <= 0;
+		return computeOrientation(v0, v1, v2) <= 0;
 	}
 
-	Circle computeCircumcircle(const AdvancedTriangle& triangle)
+	Circle computeCircumcircle(sf::Vector2f corner0, sf::Vector2f corner1, sf::Vector2f corner2)
 	{
-		assert(at(triangle, 0) != at(triangle, 1) && at(triangle, 0) != at(triangle, 2));
+		assert(corner0 != corner1 && corner0 != corner2);
 
 		// Compute midpoint of two sides
-		sf::Vector2f p = 0.5f * (at(triangle, 0) + at(triangle, 1));
-		sf::Vector2f q = 0.5f * (at(triangle, 0) + at(triangle, 2));
+		sf::Vector2f p = 0.5f * (corner0 + corner1);
+		sf::Vector2f q = 0.5f * (corner0 + corner2);
 
 		// Compute perpendicular bisectors of the sides
-		sf::Vector2f v = perpendicularVector(p - at(triangle, 0));
-		sf::Vector2f w = perpendicularVector(q - at(triangle, 0));
+		sf::Vector2f v = perpendicularVector(p - corner0);
+		sf::Vector2f w = perpendicularVector(q - corner0);
 
 		// Cross product's Z component
 		float cross = v.x * w.y - v.y * w.x;
@@ -264,7 +369,7 @@ namespace detail
 		{
 			// We define the circumcircle as extremely large, so that it will always breach the Delaunay condition
 			// The midpoint is not relevant, we simply choose the gravity center of the triangle
-			return Circle((at(triangle, 0) + at(triangle, 1) + at(triangle, 2)) / 3.f, InfiniteRadius);
+			return Circle((corner0 + corner1 + corner2) / 3.f, InfiniteRadius);
 		}
 
 		// Now we have the lines p + s*v and q + t*w with s and t being real numbers. The intersection is:
@@ -277,17 +382,26 @@ namespace detail
 		//	sf::Vector3f cross = crossProduct(v,w);
 		//	sf::Vector2f intersection = p + v * dotProduct(crossProduct(q-p, w), cross) / squaredLength(cross);
 
-		return Circle(intersection, squaredLength(intersection - at(triangle, 0)));
+		return Circle(intersection, squaredLength(intersection - corner0));
+	}
+
+	// Computes the circumcircle of triangle t, using the corners in stored order.
+	Circle computeCircumcircle(const TriangulationData& data, TrIndex t)
+	{
+		return computeCircumcircle(
+			at(data, data.corners[3*t]),
+			at(data, data.corners[3*t+1]),
+			at(data, data.corners[3*t+2]));
 	}
 
 	// Checks two edges for intersection (if one of the endpoints is equal, this doesn't count as intersection).
 	// Returns true, if the edges intersect anywhere except at the endpoints.
-	bool intersection(const AdvancedEdge& lhs, const AdvancedEdge& rhs)
+	bool intersection(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Vector2f d)
 	{
-		sf::Vector2f a = lhs[0].getPosition(); //    c
-		sf::Vector2f b = lhs[1].getPosition(); // a--+------b
-		sf::Vector2f c = rhs[0].getPosition(); //    |
-		sf::Vector2f d = rhs[1].getPosition(); //    d
+		//    c
+		// a--+------b
+		//    |
+		//    d
 
 		if (a == c || a == d || b == c || b == d)
 			return false;
@@ -296,595 +410,2335 @@ namespace detail
 			&& detail::isClockwiseOriented(a, b, c) != detail::isClockwiseOriented(a, b, d);
 	}
 
-	// Checks if edge intersects any constrained edge in constrainedEdges.
-	bool intersectsEdge(const AdvancedEdge& edge, const EdgeSet& constrainedEdges)
+	// Computes the index of a grid cell on a Hilbert curve that fills a 2^16 x 2^16 grid.
+	std::uint32_t computeHilbertIndex(std::uint32_t x, std::uint32_t y)
 	{
-		AURORA_FOREACH(const AdvancedEdge& constrainedEdge, constrainedEdges)
+		std::uint32_t index = 0;
+		for (std::uint32_t s = 1u << 15; s > 0; s >>= 1)
 		{
-			if (intersection(edge, constrainedEdge))
-				return true;
+			std::uint32_t rx = (x & s) != 0;
+			std::uint32_t ry = (y & s) != 0;
+			index += s * s * ((3 * rx) ^ ry);
+
+			// Rotate the quadrant so that the curve stays continuous (flipping higher bits doesn't matter)
+			if (ry == 0)
+			{
+				if (rx == 1)
+				{
+					x = 0xffff - x;
+					y = 0xffff - y;
+				}
+
+				std::swap(x, y);
+			}
 		}
 
-		return false;
+		return index;
 	}
 
-	// Inserts a new triangle built of the 3 corners and returns an iterator to it.
-	TriangleIterator insertTriangle(TriangleList& triangles, AdvancedVertex& corner0, AdvancedVertex& corner1, AdvancedVertex& corner2)
+	// Enlarges box so that it contains point.
+	void extendBox(EdgeBox& box, sf::Vector2f point)
 	{
-		triangles.push_back(AdvancedTriangle(corner0, corner1, corner2));
-		return --triangles.end();
+		box.min.x = std::min(box.min.x, point.x);
+		box.min.y = std::min(box.min.y, point.y);
+		box.max.x = std::max(box.max.x, point.x);
+		box.max.y = std::max(box.max.y, point.y);
 	}
 
-	// Checks whether vertex is inside the triangle (center,corner1,corner2).                       c2
-	// To be exact, this function only checks if vertex is beyond the two vectors                   /
-	// corner1-center, corner2-center, but since the original triangle is split                v   /
-	// up into three new triangles, this doesn't matter. The example returns true.        c1-----ce
-	bool isVertexInSection(const AdvancedVertex& vertex, sf::Vector2f center, sf::Vector2f corner1, sf::Vector2f corner2)
+	// Returns a box that contains nothing.
+	EdgeBox emptyBox()
 	{
-		assert(isClockwiseOriented(corner1, corner2, center));
+		const float max = std::numeric_limits<float>::max();
 
-		return crossProduct(corner1 - center, vertex.getPosition() - center) < 0.f
-			&& crossProduct(corner2 - center, vertex.getPosition() - center) >= 0.f;
+		EdgeBox box;
+		box.min = sf::Vector2f(max, max);
+		box.max = sf::Vector2f(-max, -max);
+		return box;
 	}
 
-	// The same as above, but with only 2 sections. Returns true when the vertex
-	// is located on the "left" of the vector corner2-corner1                                    v
-	// The example on the right would return true.                                           c1------c2
-	bool isVertexInSection(const AdvancedVertex& vertex, sf::Vector2f corner1, sf::Vector2f corner2)
+	// Checks whether the segment from start to end may touch the box (separating axis test).
+	bool overlapsBox(const EdgeBox& box, sf::Vector2f start, sf::Vector2f end)
 	{
-		return crossProduct(corner2 - corner1, vertex.getPosition() - corner1) >= 0.f;
-	}
+		// Bounding boxes must overlap
+		if (std::max(start.x, end.x) < box.min.x || std::min(start.x, end.x) > box.max.x
+		 || std::max(start.y, end.y) < box.min.y || std::min(start.y, end.y) > box.max.y)
+			return false;
 
-	// Moves the vertex pointed by sourceItr in sourceTriangle
-	void transferVertex(TriangleIterator sourceTriangle, VertexPtrIterator sourceItr, TriangleIterator destTriangle)
-	{
-		// Let the vertex point to the new triangle
-		(*sourceItr)->setSurroundingTriangle(destTriangle);
+		// Box corners must not all be on the same side of the segment's line
+		sf::Vector2f direction = end - start;
+		float cross1 = crossProduct(direction, box.min - start);
+		float cross2 = crossProduct(direction, box.max - start);
+		float cross3 = crossProduct(direction, sf::Vector2f(box.min.x, box.max.y) - start);
+		float cross4 = crossProduct(direction, sf::Vector2f(box.max.x, box.min.y) - start);
 
-		// Move vertex from source to dest
-		destTriangle->addVertex(**sourceItr);
-		sourceTriangle->removeVertex(sourceItr);
+		return !(cross1 > 0.f && cross2 > 0.f && cross3 > 0.f && cross4 > 0.f)
+			&& !(cross1 < 0.f && cross2 < 0.f && cross3 < 0.f && cross4 < 0.f);
 	}
 
-	// Updates the adjacent triangle's references back to oldTriangle. They are replaced by references to newTriangle (which can be invalid).
-	// @param other: The adjacent triangle of which the back-references are updated. May be invalid.
-	void updateAdjacentBackReferences(TriangleIterator oldTriangle, OptTriangleIterator newTriangle, OptTriangleIterator other)
+	// Sets up the R-tree for the constrained edges.
+	void buildEdgeTree(TriangulationData& data)
 	{
-		if (other.valid)
-		{
-			// Find out the index of other's adjacent that points to this triangle.
-			for (std::size_t i = 0; i < 3; ++i)
-			{
-				OptTriangleIterator thisOne = other.target->getAdjacentTriangle(i);
-				if (thisOne.valid && thisOne.target == oldTriangle)
-				{
-					other.target->setAdjacentTriangle(i, newTriangle);
-					return;
-				}
-			}
+		EdgeTree& tree = data.edgeTree;
+		const TrIndex nbEdges = static_cast<TrIndex>(data.constrainedEdges.size());
 
-			assert(false);
-		}
-	}
+		tree.segments.clear();
+		tree.boxes.clear();
+		tree.levelBegins.clear();
 
-	// Sets up the adjacent triangles of each element in newTriangles according to the old triangle
-	// (before the split into three new ones). Updates also the adjacents' back-references.
-	void initializeAdjacents(TriangleItrArray& newTriangles, std::size_t index, TriangleIterator oldTriangle)
-	{
-		std::size_t index1 = (index+1) % 3;
-		std::size_t index2 = (index+2) % 3;
+		if (nbEdges == 0)
+			return;
 
-		OptTriangleIterator other = oldTriangle->getAdjacentTriangle(index2);
+		// Sort edges along a Hilbert curve through their midpoints, so that each node covers a compact area
+		EdgeBox bounds = emptyBox();
+		AURORA_FOREACH(const auto& edge, data.constrainedEdges)
+		{
+			extendBox(bounds, at(data, edge.first));
+			extendBox(bounds, at(data, edge.second));
+		}
 
-		newTriangles[index]->setAdjacentTriangle(0, newTriangles[index1]);
-		newTriangles[index]->setAdjacentTriangle(1, newTriangles[index2]);
-		newTriangles[index]->setAdjacentTriangle(2, other);
+		const float cellsPerUnit = 65535.f / std::max(std::max(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y), std::numeric_limits<float>::min());
+		std::vector<std::uint32_t>& keys = data.hilbertKeys;
+		std::vector<TrIndex>& order = data.insertionOrder;
+		keys.resize(nbEdges);
+		order.clear();
+		for (TrIndex i = 0; i < nbEdges; ++i)
+		{
+			sf::Vector2f midPoint = 0.5f * (at(data, data.constrainedEdges[i].first) + at(data, data.constrainedEdges[i].second));
+			sf::Vector2f cell = cellsPerUnit * (midPoint - bounds.min);
 
-		updateAdjacentBackReferences(oldTriangle, newTriangles[index], other);
-	}
+			keys[i] = computeHilbertIndex(static_cast<std::uint32_t>(cell.x), static_cast<std::uint32_t>(cell.y));
+			order.push_back(i);
+		}
 
-	// Move all vertices in oldTriangle into the 3 new ones in newTriangles, according to their position.
-	void transferVertices3(TriangleIterator oldTriangleItr, TriangleItrArray& newTriangles, sf::Vector2f& newCornerPosition)
-	{
-		AdvancedTriangle& oldTriangle = *oldTriangleItr;
+		std::sort(order.begin(), order.end(),
+			[&keys] (TrIndex lhs, TrIndex rhs) { return keys[lhs] < keys[rhs]; });
 
-		// Determine in which sub-triangle all the remaining vertices of currentTriangle are transferred.
-		// The transfer invalidates the current iterator itr, that's why it is incremented before the call.
-		for (VertexPtrIterator itr = oldTriangle.begin(); itr != oldTriangle.end(); )
+		// Store the endpoints in leaf order, so that queries access memory contiguously
+		AURORA_FOREACH(TrIndex i, order)
+			tree.segments.push_back(std::make_pair(at(data, data.constrainedEdges[i].first), at(data, data.constrainedEdges[i].second)));
+
+		// Leaves: boxes around groups of edges. Enlarge slightly, so that rounding errors in overlapsBox() don't miss edges.
+		const float margin = 1e-4f * std::max(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y) + std::numeric_limits<float>::min();
+		tree.levelBegins.push_back(0);
+		for (TrIndex first = 0; first < nbEdges; first += EdgeTreeFanout)
 		{
-			if (isVertexInSection(**itr, newCornerPosition, at(oldTriangle, 0), at(oldTriangle, 1)))
-			{
-				transferVertex(oldTriangleItr, itr++, newTriangles[0]);
-			}
-			else if (isVertexInSection(**itr, newCornerPosition, at(oldTriangle, 1), at(oldTriangle, 2)))
-			{
-				transferVertex(oldTriangleItr, itr++, newTriangles[1]);
-			}
-			else
+			EdgeBox box = emptyBox();
+			for (TrIndex i = first; i < std::min(first + EdgeTreeFanout, nbEdges); ++i)
 			{
-				assert(isVertexInSection(**itr, newCornerPosition,  at(oldTriangle, 2),  at(oldTriangle, 0)));
-				transferVertex(oldTriangleItr, itr++, newTriangles[2]);
+				extendBox(box, tree.segments[i].first);
+				extendBox(box, tree.segments[i].second);
 			}
+
+			box.min -= sf::Vector2f(margin, margin);
+			box.max += sf::Vector2f(margin, margin);
+			tree.boxes.push_back(box);
 		}
-	}
 
-	// Of two given adjacent triangles, this function finds out which two corners are shared by both triangles, and which two are
-	// contained by only one triangle.
-	//
-	// The output parameter sharedCornerIndices1 contains the subscripts (referring to the triangles) of the first shared corner,
-	// sharedCornerIndices2 to the second shared corner, disjointCornerIndices to the corners that aren't part of the common edge.
-	// The member first refers for each pair to the first triangle, second to the second one.
-	void arrangeCorners(const AdvancedTriangle& first, const AdvancedTriangle& second,
-		IndexPair& sharedCornerIndices1, IndexPair& sharedCornerIndices2, IndexPair& disjointCornerIndices)
-	{
-		// The triangle's corners are numbered in clockwise order. For example, to compare ABC and BAD,          A
-		// we need to reverse BAD to DAB. Here, the AB subsequences are equal in ABC and DAB.                 C  |  D
-		// The variable j determines by how many elements the first sequence is rotated.                         B
-		for (std::size_t j = 0; j < 3; ++j)
+		// Inner nodes: boxes around groups of nodes of the level below, until a single root remains
+		for (;;)
 		{
-			std::array<bool, 3> match;
+			const TrIndex levelBegin = tree.levelBegins.back();
+			const TrIndex levelEnd = static_cast<TrIndex>(tree.boxes.size());
+			tree.levelBegins.push_back(levelEnd);
 
-			// Rotate vertex sequence in first until two of them are equal to second
-			for (std::size_t i = 0; i < 3; ++i)
-			{
-				// j determines rotation, 2-i is the reversed second sequence
-				match[i] = (at(first, (j+i) % 3) == at(second, 2-i));
-			}
+			if (levelEnd - levelBegin == 1)
+				break;
 
-			// If 2 of 3 corners are equal, then we know the corner arrangement.
-			if (std::accumulate(match.begin(), match.end(), 0) == 2)
+			for (TrIndex first = levelBegin; first < levelEnd; first += EdgeTreeFanout)
 			{
-				std::size_t nbSharedCorners = 0;
-
-				// Fill output parameters with the correct vertices (according to the function's interface description)
-				for (std::size_t i = 0; i < 3; ++i)
-				{
-					std::size_t firstIndex = (j+i) % 3;
-					std::size_t secondIndex = 2-i;
-
-					// A corner that both adjacent triangles (first and second) have in common
-					if (match[i])
-					{
-						assert(&first[firstIndex] == &second[secondIndex]);
-
-						if (nbSharedCorners++ == 0)
-						{
-							sharedCornerIndices1.first  = firstIndex;
-							sharedCornerIndices1.second = secondIndex;
-						}
-						else
-						{
-							sharedCornerIndices2.first  = firstIndex;
-							sharedCornerIndices2.second = secondIndex;
-						}
-					}
-
-					// A disjoint corner (contained in either first or second)
-					else
-					{
-						assert(&first[firstIndex] != &second[secondIndex]);
-
-						disjointCornerIndices.first  = firstIndex;
-						disjointCornerIndices.second = secondIndex;
-					}
-				}
-
-				// Ensure that the indices are clockwise oriented for both triangles.                       (sc1.f)|(sc1.s)
-				// first:  sc1 -> sc2 -> dc                                               first ->   (dc.f)        |        (dc.s)   <- second
-				// second: sc2 -> sc1 -> dc                                                                 (sc2.f)|(sc2.s)
-				// Two checks required because one of the old triangles may have been flat
-				if (!isClockwiseOriented(
-					at(first, sharedCornerIndices1.first),
-					at(first, sharedCornerIndices2.first),
-					at(first, disjointCornerIndices.first))
-				 || !isClockwiseOriented(
-					at(second, sharedCornerIndices2.second),
-					at(second, sharedCornerIndices1.second),
-					at(second, disjointCornerIndices.second)))
+				EdgeBox box = emptyBox();
+				for (TrIndex i = first; i < std::min(first + EdgeTreeFanout, levelEnd); ++i)
 				{
-					std::swap(sharedCornerIndices1, sharedCornerIndices2);
+					extendBox(box, tree.boxes[i].min);
+					extendBox(box, tree.boxes[i].max);
 				}
 
-				return;
+				tree.boxes.push_back(box);
 			}
 		}
-
-		// We get here when the triangles are not adjacent (and thus don't share two corners); this should not happen.
-		assert(false);
 	}
 
-	// Helper function for transferVertices2()
-	void transferVertices2Impl(TriangleIterator oldFirst, TriangleIterator oldSecond, TriangleIterator newFirst, TriangleIterator newSecond,
-		const IndexPair& disjointCornerIndices, TriangleIterator oldTriangle)
+	// Checks if the edge between the vertices start and end intersects any constrained edge.
+	// Only the constrained edges in the tree nodes that the edge overlaps are tested.
+	bool intersectsEdge(TriangulationData& data, TrIndex start, TrIndex end)
 	{
-		// Find out on which side of the new edge each vertex is located and push it into the appropriate new triangle.
-		for (VertexPtrIterator itr = oldTriangle->begin(); itr != oldTriangle->end(); )
+		EdgeTree& tree = data.edgeTree;
+		if (tree.boxes.empty())
+			return false;
+
+		sf::Vector2f a = at(data, start);
+		sf::Vector2f b = at(data, end);
+
+		// Begin at the root, which is the only node of the topmost level
+		const TrIndex rootLevel = static_cast<TrIndex>(tree.levelBegins.size() - 2);
+		tree.stack.clear();
+		tree.stack.push_back(std::make_pair(rootLevel, TrIndex(0)));
+
+		while (!tree.stack.empty())
 		{
-			if (isVertexInSection(**itr, at(*oldFirst, disjointCornerIndices.first), at(*oldSecond, disjointCornerIndices.second)))
+			const TrIndex level = tree.stack.back().first;
+			const TrIndex node = tree.stack.back().second;
+			tree.stack.pop_back();
+
+			if (!overlapsBox(tree.boxes[tree.levelBegins[level] + node], a, b))
+				continue;
+
+			// Leaf: test the edges
+			if (level == 0)
 			{
-				transferVertex(oldTriangle, itr++, newFirst);
+				const TrIndex nbEdges = static_cast<TrIndex>(tree.segments.size());
+				for (TrIndex i = node * EdgeTreeFanout; i < std::min((node + 1) * EdgeTreeFanout, nbEdges); ++i)
+				{
+					if (intersection(a, b, tree.segments[i].first, tree.segments[i].second))
+						return true;
+				}
 			}
+
+			// Inner node: visit the children
 			else
 			{
-				assert(isVertexInSection(**itr, at(*oldSecond, disjointCornerIndices.second), at(*oldFirst, disjointCornerIndices.first)));
-				transferVertex(oldTriangle, itr++, newSecond);
+				const TrIndex levelSize = tree.levelBegins[level] - tree.levelBegins[level - 1];
+				for (TrIndex child = node * EdgeTreeFanout; child < std::min((node + 1) * EdgeTreeFanout, levelSize); ++child)
+					tree.stack.push_back(std::make_pair(level - 1, child));
 			}
 		}
+
+		return false;
 	}
 
-	// Moves all vertices in oldTriangle to either newFirst or newSecond, depending on which side of the new
-	// edge they are situated.
-	void transferVertices2(TriangleIterator oldFirst, TriangleIterator oldSecond, TriangleIterator newFirst, TriangleIterator newSecond,
-		const IndexPair& disjointCornerIndices)
+	// Checks whether the edge formed of the two specified vertices is constrained.
+	// Requires data.constrainedEdges to be normalized (see normalizeConstrainedEdges()).
+	bool isEdgeConstrained(const TriangulationData& data, TrIndex start, TrIndex end)
 	{
-		transferVertices2Impl(oldFirst, oldSecond, newFirst, newSecond, disjointCornerIndices, oldFirst);
-		transferVertices2Impl(oldFirst, oldSecond, newFirst, newSecond, disjointCornerIndices, oldSecond);
+		std::pair<TrIndex, TrIndex> edge(std::min(start, end), std::max(start, end));
+		return std::binary_search(data.constrainedEdges.begin(), data.constrainedEdges.end(), edge);
 	}
 
-	// Copies the adjacent triangle from oldTriangle at oldIndex to newTriangle at newIndex (only one reference).
-	// Additionally, the referencee is updated so that it points to newTriangle instead of oldTriangle.
-	void updateAdjacentRelation(TriangleIterator oldTriangle, std::size_t oldIndex, TriangleIterator newTriangle, std::size_t newIndex)
+	// Orders each constrained edge's vertices and sorts the edges, so that they can be looked up by isEdgeConstrained().
+	// Edges that connect two vertices at the same position are dropped, as they cannot be part of any triangle.
+	void normalizeConstrainedEdges(TriangulationData& data)
 	{
-		OptTriangleIterator other = oldTriangle->getAdjacentTriangle(oldIndex);
+		std::vector<std::pair<TrIndex, TrIndex>>& edges = data.constrainedEdges;
+
+		std::size_t kept = 0;
+		for (std::size_t i = 0; i < edges.size(); ++i)
+		{
+			std::pair<TrIndex, TrIndex> edge = edges[i];
+			assert(at(data, edge.first) != at(data, edge.second));
 
-		// Update this triangle's references to adjacent triangles.
-		newTriangle->setAdjacentTriangle(newIndex, other);
+			if (edge.first > edge.second)
+				std::swap(edge.first, edge.second);
 
-		// Update adjacent triangles's references to this triangle.
-		updateAdjacentBackReferences(oldTriangle, newTriangle, other);
+			edges[kept++] = edge;
+		}
+
+		edges.resize(kept);
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
 	}
 
-	// Performs an edge flip, i.e. both triangles are merged and the resulting quadrilateral is split again, but into two different
-	// triangles  (choose the other diagonal as cutting edge).
-	// @param oldFirst				Iterator to the old first triangle. This iterator is invalidated during the operation.
-	// @param oldSecond				Like oldFirst, but iterator to the second triangle.
-	// @param sharedCornerIndices1	Indices of the corners in oldFirst and oldSecond that refer to the shared corners.
-	// @param sharedCornerIndices2	Like 1, but the other shared corner.
-	// @param disjointCornerIndices Indices of the non-shared, disjoint corners.
-	// @return						Pair of the newly created triangles
-	TriangleItrPair flipEdges(TriangleList& triangles, TriangleIterator oldFirst, TriangleIterator oldSecond,
-		const IndexPair& sharedCornerIndices1, const IndexPair& sharedCornerIndices2, const IndexPair& disjointCornerIndices)
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Sets the three corners of triangle t.
+	void setTriangle(TriangulationData& data, TrIndex t, TrIndex corner0, TrIndex corner1, TrIndex corner2)
 	{
-		// Create the new triangles which are going to outlive this function
-		TriangleIterator newFirst = insertTriangle(triangles,
-			(*oldFirst)[sharedCornerIndices1.first],			// (sc1)
-			(*oldSecond)[disjointCornerIndices.second],			// (dc.s)
-			(*oldFirst)[disjointCornerIndices.first]);			// (dc.f)
+		data.corners[3*t]   = corner0;
+		data.corners[3*t+1] = corner1;
+		data.corners[3*t+2] = corner2;
 
-		TriangleIterator newSecond = insertTriangle(triangles,
-			(*oldSecond)[sharedCornerIndices2.second],			// (sc2)
-			(*oldFirst)[disjointCornerIndices.first],			// (dc.f)
-			(*oldSecond)[disjointCornerIndices.second]);		// (dc.s)
+		data.vertexEdges[corner0] = 3*t;
+		data.vertexEdges[corner1] = 3*t+1;
+		data.vertexEdges[corner2] = 3*t+2;
+	}
 
-		// Move each vertex to the new corresponding triangle
-		transferVertices2(oldFirst, oldSecond, newFirst, newSecond, disjointCornerIndices);
+	// Lets two half-edges refer to each other. The second one may be invalid (border of the triangulation).
+	void linkHalfEdges(TriangulationData& data, TrIndex halfEdge, TrIndex twin)
+	{
+		data.twins[halfEdge] = twin;
 
-		// Adapt referenced adjacents - note that the old indices                     //                       (dc.f)              edge
-		// (non-shared corners) now form the end points of the new edge.              // oldFirst    (sc2.f)          (sc1.f)      flip            (1)|(2)
-		updateAdjacentRelation(oldFirst, sharedCornerIndices1.first, newSecond, 2);	  //             ------------------------       ->       (0)      |      (0)
-		updateAdjacentRelation(oldFirst, sharedCornerIndices2.first, newFirst, 1);    // oldSecond   (sc2.s)          (sc1.s)                      (2)|(1)
-		updateAdjacentRelation(oldSecond, sharedCornerIndices1.second, newSecond, 1); //                       (dc.s)
-		updateAdjacentRelation(oldSecond, sharedCornerIndices2.second, newFirst, 2);  //                                                     newSecond|newFirst
+		if (twin != InvalidTrIndex)
+			data.twins[twin] = halfEdge;
+	}
 
-		// Of course, the new triangles are adjacent to each other.
-		newFirst->setAdjacentTriangle(0, newSecond);
-		newSecond->setAdjacentTriangle(0, newFirst);
+	// Appends a new triangle with undefined corners and returns its index.
+	TrIndex appendTriangle(TriangulationData& data)
+	{
+		TrIndex t = static_cast<TrIndex>(data.firstVertices.size());
 
-		// Mark old triangles for removal; they're not needed anymore.
-		oldFirst->setFlagged(true);
-		oldSecond->setFlagged(true);
+		data.corners.resize(data.corners.size() + 3);
+		data.twins.resize(data.twins.size() + 3, InvalidTrIndex);
+		data.firstVertices.push_back(InvalidTrIndex);
 
-		return TriangleItrPair(newFirst, newSecond);
+		return t;
 	}
 
-	// Returns true if the triangle contains the passed vertex as a corner.
-	bool hasCorner(const AdvancedTriangle& triangle, const AdvancedVertex& corner)
+	// Adds a not yet inserted vertex to the list of triangle t.
+	void pushRemainingVertex(TriangulationData& data, TrIndex t, TrIndex vertex)
 	{
-		// Note: Comparing addresses requires that vertices be stored only once and in a non-invalidating container.
-		return &triangle[0] == &corner
-			|| &triangle[1] == &corner
-			|| &triangle[2] == &corner;
+		data.nextVertices[vertex] = data.firstVertices[t];
+		data.firstVertices[t] = vertex;
+		data.vertexTriangles[vertex] = t;
 	}
 
-	// Returns true if triangle contains at least one of three corners in the corners triangle
-	bool has1Of3Corners(const AdvancedTriangle& triangle, const AdvancedTriangle& corners)
+	// Detaches the list of remaining vertices from triangle t and returns its first element.
+	TrIndex takeRemainingVertices(TriangulationData& data, TrIndex t)
 	{
-		return hasCorner(triangle, corners[0])
-			|| hasCorner(triangle, corners[1])
-			|| hasCorner(triangle, corners[2]);
+		TrIndex first = data.firstVertices[t];
+		data.firstVertices[t] = InvalidTrIndex;
+
+		return first;
 	}
 
-	// Returns true if any of the boundary (dummy) vertices is part of first/second's shared edge.
-	bool isSharedBoundary(const AdvancedTriangle& boundaryTriangle, const AdvancedTriangle& first,
-		const IndexPair& sharedCornerIndices1, const IndexPair& sharedCornerIndices2)
+	// Checks whether vertex is inside the triangle (center,corner1,corner2).                       c2
+	// To be exact, this function only checks if vertex is beyond the two vectors                   /
+	// corner1-center, corner2-center, but since the original triangle is split                v   /
+	// up into three new triangles, this doesn't matter. The example returns true.        c1-----ce
+	bool isVertexInSection(sf::Vector2f vertex, sf::Vector2f center, sf::Vector2f corner1, sf::Vector2f corner2)
 	{
-		return hasCorner(boundaryTriangle, first[sharedCornerIndices1.first])
-			|| hasCorner(boundaryTriangle, first[sharedCornerIndices2.first]);
+		assert(isClockwiseOriented(corner1, corner2, center));
+
+		return computeOrientation(center, corner1, vertex) < 0
+			&& computeOrientation(center, corner2, vertex) >= 0;
 	}
 
-	// Returns true if any of the boundary (dummy) vertices is either first's or second's disjoint corner.
-	bool isDisjointBoundary(const AdvancedTriangle& boundaryTriangle, const AdvancedTriangle& first, const AdvancedTriangle& second,
-		const IndexPair& disjointCornerIndices)
+	// The same as above, but with only 2 sections. Returns true when the vertex
+	// is located on the "left" of the vector corner2-corner1                                    v
+	// The example on the right would return true.                                           c1------c2
+	bool isVertexInSection(sf::Vector2f vertex, sf::Vector2f corner1, sf::Vector2f corner2)
 	{
-		return hasCorner(boundaryTriangle, first[disjointCornerIndices.first])
-			|| hasCorner(boundaryTriangle, second[disjointCornerIndices.second]);
+		return computeOrientation(corner1, corner2, vertex) >= 0;
 	}
 
-	bool ensureLocalDelaunay(TriangleList& triangles, TriangleIterator first, TriangleIterator second, const AdvancedTriangle& boundaryTriangle,
-		const EdgeSet& constrainedEdges);
-
-	// Applies the check for the Delaunay condition recursively to the triangles neighbors.
-	// @return true if an edge flip is performed, false otherwise.
-	bool ensureLocalDelaunayAdjacent(TriangleList& triangles, TriangleIterator triangleItr, std::size_t adjacentIndex, const AdvancedTriangle& boundaryTriangle,
-		const EdgeSet& constrainedEdges)
+	// Performs an edge flip, i.e. both triangles are merged and the resulting quadrilateral is split again, but into two different
+	// triangles (choose the other diagonal as cutting edge). The triangles are overwritten in place, their indices stay valid.
+	//
+	//          a                          a
+	//        / | \                      /   \             first:  (a,b,c) -> (a,d,c)
+	//      c   |   d        ->        c ----- d           second: (b,a,d) -> (b,c,d)
+	//        \ | /                      \   /
+	//          b                          b
+	void flipEdge(TriangulationData& data, TrIndex halfEdge)
 	{
-		OptTriangleIterator itr = triangleItr->getAdjacentTriangle(adjacentIndex);
+		const TrIndex twin = data.twins[halfEdge];
+		const TrIndex first = halfEdge / 3;
+		const TrIndex second = twin / 3;
+
+		const TrIndex a = data.corners[halfEdge];
+		const TrIndex b = data.corners[nextHalfEdge(halfEdge)];
+		const TrIndex c = data.corners[previousHalfEdge(halfEdge)];
+		const TrIndex d = data.corners[previousHalfEdge(twin)];
+
+		// Remember the outer neighbors before the half-edges are overwritten
+		const TrIndex outerBC = data.twins[nextHalfEdge(halfEdge)];
+		const TrIndex outerCA = data.twins[previousHalfEdge(halfEdge)];
+		const TrIndex outerAD = data.twins[nextHalfEdge(twin)];
+		const TrIndex outerDB = data.twins[previousHalfEdge(twin)];
+
+		setTriangle(data, first, a, d, c);
+		setTriangle(data, second, b, c, d);
+
+		linkHalfEdges(data, 3*first,    outerAD);
+		linkHalfEdges(data, 3*first+1,  3*second+1);
+		linkHalfEdges(data, 3*first+2,  outerCA);
+		linkHalfEdges(data, 3*second,   outerBC);
+		linkHalfEdges(data, 3*second+2, outerDB);
+
+		// Find out on which side of the new edge each vertex is located and push it into the appropriate new triangle.
+		sf::Vector2f positionC = at(data, c);
+		sf::Vector2f positionD = at(data, d);
+
+		TrIndex lists[2] = { takeRemainingVertices(data, first), takeRemainingVertices(data, second) };
+		for (std::size_t i = 0; i < 2; ++i)
+		{
+			for (TrIndex vertex = lists[i]; vertex != InvalidTrIndex; )
+			{
+				TrIndex next = data.nextVertices[vertex];
+
+				if (isVertexInSection(at(data, vertex), positionC, positionD))
+				{
+					pushRemainingVertex(data, first, vertex);
+				}
+				else
+				{
+					assert(isVertexInSection(at(data, vertex), positionD, positionC));
+					pushRemainingVertex(data, second, vertex);
+				}
+
+				vertex = next;
+			}
+		}
 
-		return itr.valid && ensureLocalDelaunay(triangles, triangleItr, itr.target, boundaryTriangle, constrainedEdges);
+		// Ensure that the adjacent triangles locally conform to Delaunay, as well. Pushed in reverse order of checking.
+		// On average, this stops in O(1) time, the adjacent triangles are already Delaunay-conforming.
+		data.pendingEdges.push_back(3*second);
+		data.pendingEdges.push_back(3*second+2);
+		data.pendingEdges.push_back(3*first);
+		data.pendingEdges.push_back(3*first+2);
 	}
 
-	// Flips edges and enforces the Delaunay condition at adjacent triangles
-	void changeEdgeSituation(TriangleList& triangles, TriangleIterator first, TriangleIterator second, const AdvancedTriangle& boundaryTriangle,
-		const EdgeSet& constrainedEdges, const IndexPair& sharedCornerIndices1, const IndexPair& sharedCornerIndices2, const IndexPair& disjointCornerIndices)
+	// Checks whether the quadrilateral formed by the triangles (a,b,c) and (b,a,d) is convex, so that the diagonal a-b can be
+	// replaced by c-d.
+	bool isConvexQuadrilateral(const TriangulationData& data, TrIndex a, TrIndex b, TrIndex c, TrIndex d)
 	{
-		TriangleItrPair newTriangles = flipEdges(triangles, first, second, sharedCornerIndices1, sharedCornerIndices2, disjointCornerIndices);
-
-		// Ensure that the adjacent triangles locally conform to Delaunay, as well.
-		// If one function call returns true, don't execute the others because iterators are invalidated.
-		// On average, the recursion stops on O(1) time, the adjacent triangles are already Delaunay-conforming.
-		ensureLocalDelaunayAdjacent(triangles, newTriangles.first, 1, boundaryTriangle, constrainedEdges);
-		ensureLocalDelaunayAdjacent(triangles, newTriangles.first, 2, boundaryTriangle, constrainedEdges);
-		ensureLocalDelaunayAdjacent(triangles, newTriangles.second, 1, boundaryTriangle, constrainedEdges);
-		ensureLocalDelaunayAdjacent(triangles, newTriangles.second, 2, boundaryTriangle, constrainedEdges);
+		return !isClockwiseOriented(at(data, c), at(data, d), at(data, a))
+			&& !isClockwiseOriented(at(data, d), at(data, c), at(data, b));
 	}
 
-	// Checks whether the shared edge of two triangles must be moved (to the other diagonal of the quadrilateral)
-	// and performs the necessary actions in this case, so that the triangulation locally conforms Delaunay.
-	// Also, the adjacent triangles are checked and edge-flipped, if necessary. On average, this requires constant
-	// time because the surrounding triangles already satisfy Delaunay before the flip of this triangle.
-	// If an edge flip is performed, true is returned and the new triangles are stored in the input/output parameters first, second.
-	// @return true if an edge flip is performed, false otherwise.
-	bool ensureLocalDelaunay(TriangleList& triangles, TriangleIterator first, TriangleIterator second, const AdvancedTriangle& boundaryTriangle,
-		const EdgeSet& constrainedEdges)
+	// Checks whether the half-edge shared by two triangles must be moved (to the other diagonal of the quadrilateral)
+	// and performs the necessary flip in this case, so that the triangulation locally conforms Delaunay. The adjacent
+	// edges are then scheduled for the same check in data.pendingEdges.
+	void ensureLocalDelaunay(TriangulationData& data, TrIndex halfEdge)
 	{
 		// Note: If the merged quadrilateral is concave, the Delaunay condition will locally already be satisfied.
+		const TrIndex twin = data.twins[halfEdge];
+		if (twin == InvalidTrIndex)
+			return;
 
-		// Flagged triangles are going to be removed, don't take them into account
-		if (first->isFlagged() || second->isFlagged())
-			return false;
-
-		// Find out which triangle indices refer to the corners that are shared by both triangles, and which to the disjoint ones.
-		IndexPair sharedCornerIndices1;
-		IndexPair sharedCornerIndices2;
-		IndexPair disjointCornerIndices;
-		arrangeCorners(*first, *second, sharedCornerIndices1, sharedCornerIndices2, disjointCornerIndices);
-
-		// Check if we must flip edges because of the boundaries (the triangles there don't have to conform Delaunay, but the triangles inside do)
-		bool disjointBoundary = isDisjointBoundary(boundaryTriangle, *first, *second, disjointCornerIndices);
-		bool sharedBoundary = isSharedBoundary(boundaryTriangle, *first, sharedCornerIndices1, sharedCornerIndices2);
+		// Shared corners a, b and disjoint corners c (first triangle), d (second triangle). Both triangles are clockwise:
+		// first: a -> b -> c, second: b -> a -> d
+		const TrIndex a = data.corners[halfEdge];
+		const TrIndex b = data.corners[nextHalfEdge(halfEdge)];
+		const TrIndex c = data.corners[previousHalfEdge(halfEdge)];
+		const TrIndex d = data.corners[previousHalfEdge(twin)];
 
-		// The following additional checks are not required if constrained edges are always part of a merged quadrilateral (=two adjacent triangles).
-		// But in general, we may have constrained edges that span many triangles, and the local Delaunay condition doesn't capture them.
-		bool sharedBlocking = intersectsEdge(AdvancedEdge((*first)[sharedCornerIndices1.first], (*first)[sharedCornerIndices2.first]), constrainedEdges);
-		bool disjointBlocking = intersectsEdge(AdvancedEdge((*first)[disjointCornerIndices.first], (*second)[disjointCornerIndices.second]), constrainedEdges);
+		// A constrained edge that is already part of the triangulation is never flipped. Usually, the intersection test below
+		// protects it as well, but the dynamic triangulation has no edge tree, and collinear points may escape that test.
+		if (isEdgeConstrained(data, a, b))
+			return;
 
-		// These two bools express whether the disjoint edge respectively the shared edge MUST be flipped.
-		bool disjointEdgeEnforced = disjointBoundary || disjointBlocking;
-		bool sharedEdgeEnforced = sharedBoundary || sharedBlocking;
+		// Check if we must flip edges because of the boundaries (the triangles there don't have to conform Delaunay, but the triangles inside do).
+		// The additional intersection checks are not required if constrained edges are always part of a merged quadrilateral (=two adjacent
+		// triangles). But in general, we may have constrained edges that span many triangles, and the local Delaunay condition doesn't capture them.
+		// These two bools express whether the disjoint edge respectively the shared edge MUST be flipped. The disjoint one is only evaluated
+		// when its value matters, since the intersection tests are comparatively expensive.
+		bool sharedEdgeEnforced = isBoundary(a) || isBoundary(b) || intersectsEdge(data, a, b);
 
 		// If the Delaunay test concerns one of the initial vertices, we pretend that those vertices are never inside the circumcircle.
 		// This is required because we don't want to perform edge flips at the boundary of the very big outer triangle.
 		// The same applies to constrained edges as input of the Constrained Delaunay Triangulation.
-		if (disjointEdgeEnforced && !sharedEdgeEnforced)
-			return false;
-
-		if (sharedEdgeEnforced && !disjointEdgeEnforced)
+		if (sharedEdgeEnforced)
 		{
-			// If the merged quadrilateral isn't convex, we may of course not flip edges (since the new edge would be located outside both triangles).
-			if (isClockwiseOriented(at(*first, disjointCornerIndices.first), at(*second, disjointCornerIndices.second), at(*first, sharedCornerIndices1.first))
-			 || isClockwiseOriented(at(*second, disjointCornerIndices.second), at(*first, disjointCornerIndices.first), at(*first, sharedCornerIndices2.first)))
-				return false;
+			bool disjointEdgeEnforced = isBoundary(c) || isBoundary(d) || intersectsEdge(data, c, d);
 
-			changeEdgeSituation(triangles, first, second, boundaryTriangle, constrainedEdges, sharedCornerIndices1, sharedCornerIndices2, disjointCornerIndices);
-			return true;
+			if (!disjointEdgeEnforced)
+			{
+				// If the merged quadrilateral isn't convex, we may of course not flip edges (since the new edge would be located outside both triangles).
+				if (isConvexQuadrilateral(data, a, b, c, d))
+					flipEdge(data, halfEdge);
+
+				return;
+			}
 		}
 
 		// If the vertex of the other triangle is inside this triangle's circumcircle, the Delaunay condition is locally breached and we need to flip edges.
 		// Independently, there can be an enforced edge flip (at the boundary, or because of the constraints).
-		// Condition (2) is actually not necessary, since the Delaunay condition is symmetric to both triangles. However, rounding errors may occur
-		// at close points. Condition (0) makes sure that we don't perform a pointless edge flip if both triangles are degenerate (flat).
-		Circle circle = computeCircumcircle(*first);
-		Circle circle2 = computeCircumcircle(*second);
-		if (!(circle.squaredRadius == InfiniteRadius && circle2.squaredRadius == InfiniteRadius)				// (0)
-		 && squaredLength(at(*second, disjointCornerIndices.second) - circle.midPoint) < circle.squaredRadius	// (1)
-		 && squaredLength(at(*first, disjointCornerIndices.first) - circle2.midPoint) < circle2.squaredRadius)	// (2)
-		{
-			changeEdgeSituation(triangles, first, second, boundaryTriangle, constrainedEdges, sharedCornerIndices1, sharedCornerIndices2, disjointCornerIndices);
-			return true;
+		// The predicates are exact, so conditions (1) and (2) are equivalent unless one triangle is flat, and its circumcircle is considered infinite.
+		// Condition (0) makes sure that we don't perform a pointless edge flip if both triangles are degenerate (flat).
+		// Condition (3) also follows from the Delaunay condition, except when one of the triangles is flat; the flip would then fold the
+		// triangulation over.
+		const sf::Vector2f positionA = at(data, a);
+		const sf::Vector2f positionB = at(data, b);
+		const sf::Vector2f positionC = at(data, c);
+		const sf::Vector2f positionD = at(data, d);
+		const bool flat = computeOrientation(positionA, positionB, positionC) == 0;
+		const bool flat2 = computeOrientation(positionB, positionA, positionD) == 0;
+		if (!(flat && flat2)																	// (0)
+		 && isInsideCircumcircle(positionA, positionB, positionC, positionD)					// (1)
+		 && isInsideCircumcircle(positionB, positionA, positionD, positionC)					// (2)
+		 && isConvexQuadrilateral(data, a, b, c, d))											// (3)
+		{
+			// An enforced disjoint edge (while the shared one is not) forbids the flip. A flat triangle at the convex hull, however,
+			// is flipped towards the boundary vertex; otherwise it would remain in the result.
+			if (!sharedEdgeEnforced && (((isBoundary(c) || isBoundary(d)) && !flat && !flat2) || intersectsEdge(data, c, d)))
+				return;
+
+			flipEdge(data, halfEdge);
 		}
 
 		// Otherwise, the triangles are Delaunay at the moment and no edge flip is required.
-		return false;
 	}
 
-	// Inserts the specified vertex into the list of triangles.
-	void insertPoint(TriangleList& triangles, AdvancedVertex& vertex, const AdvancedTriangle& boundaryTriangle, const EdgeSet& constrainedEdges)
+	// Checks all pending half-edges for the Delaunay condition. Flips push further half-edges.
+	void restoreDelaunay(TriangulationData& data)
 	{
-		TriangleIterator oldTriangleItr = vertex.getSurroundingTriangle().target;
-		AdvancedTriangle& oldTriangle = *oldTriangleItr;
-
-		assert(isClockwiseOriented(at(oldTriangle, 0), at(oldTriangle, 1), at(oldTriangle, 2)));
-
-		// Split triangle up into three new sub-triangles, each consisting of two old corners and the new vertex
-		TriangleItrArray newTriangles = {
-			insertTriangle(triangles, oldTriangle[0], oldTriangle[1], vertex),
-			insertTriangle(triangles, oldTriangle[1], oldTriangle[2], vertex),
-			insertTriangle(triangles, oldTriangle[2], oldTriangle[0], vertex)};
+		while (!data.pendingEdges.empty())
+		{
+			TrIndex halfEdge = data.pendingEdges.back();
+			data.pendingEdges.pop_back();
 
-		// Assign the adjacent triangles to the new triangles
-		for (std::size_t i = 0; i < 3; ++i)
-			initializeAdjacents(newTriangles, i, oldTriangleItr);
+			ensureLocalDelaunay(data, halfEdge);
+		}
+	}
 
-		// Remove current vertex - as soon as it forms a triangle corner, it counts no longer as remaining vertex
-		sf::Vector2f newCornerPosition = vertex.getPosition();
-		oldTriangle.removeVertex(vertex);
+	// Inserts the specified vertex by splitting the triangle that contains it.
+	void insertPoint(TriangulationData& data, TrIndex vertex)
+	{
+		const TrIndex t = data.vertexTriangles[vertex];
+		const TrIndex corner0 = data.corners[3*t];
+		const TrIndex corner1 = data.corners[3*t+1];
+		const TrIndex corner2 = data.corners[3*t+2];
+
+		assert(isClockwiseOriented(at(data, corner0), at(data, corner1), at(data, corner2)));
+
+		// Split triangle up into three sub-triangles, each consisting of two old corners and the new vertex.
+		// The first one replaces the old triangle, so that its outer half-edge keeps its twin.
+		const TrIndex t1 = appendTriangle(data);
+		const TrIndex t2 = appendTriangle(data);
+		const TrIndex outer1 = data.twins[3*t+1];
+		const TrIndex outer2 = data.twins[3*t+2];
+
+		setTriangle(data, t,  corner0, corner1, vertex);
+		setTriangle(data, t1, corner1, corner2, vertex);
+		setTriangle(data, t2, corner2, corner0, vertex);
+
+		// Half-edge 0 is the outer edge of each new triangle, 1 and 2 are shared with the neighbors
+		linkHalfEdges(data, 3*t1, outer1);
+		linkHalfEdges(data, 3*t2, outer2);
+		linkHalfEdges(data, 3*t+1,  3*t1+2);
+		linkHalfEdges(data, 3*t1+1, 3*t2+2);
+		linkHalfEdges(data, 3*t2+1, 3*t+2);
+
+		// Move each remaining vertex to its corresponding new surrounding triangle. The inserted vertex itself no longer counts as remaining.
+		sf::Vector2f center = at(data, vertex);
+		sf::Vector2f position0 = at(data, corner0);
+		sf::Vector2f position1 = at(data, corner1);
+		sf::Vector2f position2 = at(data, corner2);
+
+		for (TrIndex remaining = takeRemainingVertices(data, t); remaining != InvalidTrIndex; )
+		{
+			TrIndex next = data.nextVertices[remaining];
+			sf::Vector2f position = at(data, remaining);
 
-		// Move each vertex to its corresponding new surrounding triangle
-		transferVertices3(oldTriangleItr, newTriangles, newCornerPosition);
+			if (remaining == vertex)
+			{
+				// Skip
+			}
+			else if (isVertexInSection(position, center, position0, position1))
+			{
+				pushRemainingVertex(data, t, remaining);
+			}
+			else if (isVertexInSection(position, center, position1, position2))
+			{
+				pushRemainingVertex(data, t1, remaining);
+			}
+			else
+			{
+				assert(isVertexInSection(position, center, position2, position0));
+				pushRemainingVertex(data, t2, remaining);
+			}
 
-		// Remove the old big triangle, we have three new ones
-		triangles.erase(oldTriangleItr);
+			remaining = next;
+		}
 
 		// For each newly created triangle, we must ensure that the Delaunay condition with its adjacent is kept up.
-		// The variable adjacent (third argument of ensureLocalDelaunay()) is the adjacent of the old triangle.
-		// Corner number 2 is always the vertex inserted in this function, so the triangle on the opposite is the sought one.
-		for (std::size_t i = 0; i < 3; ++i)
-		{
-			OptTriangleIterator adjacent = newTriangles[i]->getAdjacentTriangle(2);
-
-			if (adjacent.valid)
-				ensureLocalDelaunay(triangles, newTriangles[i], adjacent.target, boundaryTriangle, constrainedEdges);
-		}
+		// Corner number 2 is always the inserted vertex, so half-edge 0 is the one shared with the old neighbor.
+		data.pendingEdges.push_back(3*t2);
+		data.pendingEdges.push_back(3*t1);
+		data.pendingEdges.push_back(3*t);
 
-		// Remove currently flagged triangles. Don't do this earlier because of iterator invalidations.
-		triangles.remove_if(std::mem_fn(&AdvancedTriangle::isFlagged));
+		restoreDelaunay(data);
 	}
 
-	// Creates 3 "dummy" vertices that form a huge triangle which later includes all other vertices
-	// (every element of allVertices).
-	void createBoundaryPoints(VertexCtr& allVertices, TriangleList& triangles)
+	// Computes a biased randomized insertion order (BRIO) of the non-boundary vertices: rounds of doubling size, each
+	// sorted along a Hilbert curve. Spatially close vertices are inserted after each other, which keeps walks short,
+	// while the randomization of rounds keeps the expected amount of edge flips low.
+	void computeInsertionOrder(TriangulationData& data)
 	{
-		assert(allVertices.empty());
-		assert(triangles.empty());
+		const TrIndex nbVertices = static_cast<TrIndex>(data.positions.size());
 
-		// Add boundary vertices (choose arbitrary, clockwise oriented positions)
-		allVertices.push_back(AdvancedVertex(-1, 0));
-		allVertices.push_back(AdvancedVertex( 0,+1));
-		allVertices.push_back(AdvancedVertex(+1, 0));
+		// Bounding box of the vertices
+		EdgeBox bounds = emptyBox();
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices; ++vertex)
+			extendBox(bounds, data.positions[vertex]);
 
-		// First triangle in list is the one containing the three boundary vertices
-		triangles.push_back(AdvancedTriangle(allVertices[0], allVertices[1], allVertices[2]));
+		// Quantize positions to the Hilbert grid
+		const float cellsPerUnit = 65535.f / std::max(std::max(bounds.max.x - bounds.min.x, bounds.max.y - bounds.min.y), std::numeric_limits<float>::min());
+		data.hilbertKeys.resize(nbVertices);
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices; ++vertex)
+		{
+			sf::Vector2f cell = cellsPerUnit * (data.positions[vertex] - bounds.min);
+			data.hilbertKeys[vertex] = computeHilbertIndex(static_cast<std::uint32_t>(cell.x), static_cast<std::uint32_t>(cell.y));
+		}
 
-		for (std::size_t i = 0; i < 3; ++i)
-			allVertices[i].setSurroundingTriangle(triangles.begin());
-	}
+		// Shuffle with a fixed seed, so that the result is reproducible
+		data.insertionOrder.clear();
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices; ++vertex)
+			data.insertionOrder.push_back(vertex);
 
-	// Sets the initial point positions so that the triangle of dummy vertices includes all other vertices.
-	// Like this, we can start the algorithm seamlessly.
-	void setBoundaryPositions(const VertexCtr& allVertices, AdvancedTriangle& boundaryTriangle)
-	{
-		// Find maximal coordinate in any direction
-		float maxCoord = 0.f;
-		AURORA_FOREACH(const AdvancedVertex& vertex, allVertices)
-		{
-			sf::Vector2f position = vertex.getPosition();
+		std::minstd_rand random;
+		std::shuffle(data.insertionOrder.begin(), data.insertionOrder.end(), random);
 
-			maxCoord = std::max(maxCoord, std::abs(position.x));
-			maxCoord = std::max(maxCoord, std::abs(position.y));
-		}
+		// Each round contains the second half of the remaining vertices; small rounds are not split further
+		const std::vector<std::uint32_t>& keys = data.hilbertKeys;
+		for (std::size_t roundEnd = data.insertionOrder.size(); roundEnd > 0; )
+		{
+			std::size_t roundBegin = (roundEnd > 64) ? roundEnd / 2 : 0;
 
-		// Reduce probability to have a 3 collinear points (which can't be triangulated) by slightly moving boundary points. Take arbitrary value...
-		const float epsilon = 0.000372f;
+			std::sort(data.insertionOrder.begin() + roundBegin, data.insertionOrder.begin() + roundEnd,
+				[&keys] (TrIndex lhs, TrIndex rhs) { return keys[lhs] < keys[rhs]; });
 
-		// Overwrite 3 dummy vertices so that the resulting triangle certainly surrounds all other vertices.
-		maxCoord *= 4.f;
-		boundaryTriangle[0] = AdvancedVertex(epsilon, maxCoord-epsilon);
-		boundaryTriangle[1] = AdvancedVertex(maxCoord+epsilon, -epsilon);
-		boundaryTriangle[2] = AdvancedVertex(-maxCoord-epsilon, -maxCoord+epsilon);
+			roundEnd = roundBegin;
+		}
 	}
 
-	// Checks whether the edge formed of the two specified points is contained in constrainedEdges.
-	// Copies vertex parameters, but they're not further used.
-	bool isEdgeConstrained(const EdgeSet& constrainedEdges, AdvancedVertex startPoint, AdvancedVertex endPoint)
+	// Finds the triangle that contains position, by walking from the triangle start towards it.
+	// In each step, the walk crosses an edge behind which the position is located. The edge to test first is chosen
+	// randomly, since the walk might otherwise cycle in regions that are not Delaunay (near boundary or constrained edges).
+	TrIndex locateTriangle(const TriangulationData& data, sf::Vector2f position, TrIndex start, std::minstd_rand& random)
 	{
-		AdvancedEdge adv(startPoint, endPoint);
-		EdgeSet::const_iterator candidate = constrainedEdges.find(adv);
+		TrIndex current = start;
 
-		// Just to make sure the set predicate really works. Otherwise: return candidate != ..end() && .. && ..;
-		assert(candidate == constrainedEdges.end()
-		 || adv[0].getPosition() == (*candidate)[0].getPosition()
-		 && adv[1].getPosition() == (*candidate)[1].getPosition());
+		for (;;)
+		{
+			TrIndex offset = random() % 3;
+			TrIndex i = 0;
 
-		return candidate != constrainedEdges.end();
-	}
+			for (; i < 3; ++i)
+			{
+				TrIndex e = 3*current + (offset + i) % 3;
+				sf::Vector2f edgeStart = at(data, data.corners[e]);
+				sf::Vector2f edgeEnd = at(data, data.corners[nextHalfEdge(e)]);
 
-	// Checks if the adjacent triangle is in use (i.e. inside the polygon) and returns a valid OptTriangleIterator in this case.
-	// Otherwise, the latter is invalid.
-	OptTriangleIterator hasUnusedAdjacent(const AdvancedTriangle& triangle, std::size_t index, const EdgeSet& constrainedEdges)
-	{
-		if (isEdgeConstrained(constrainedEdges, triangle[(index+1) % 3], triangle[(index+2) % 3]))
-			return OptTriangleIterator();
-		else
-			return triangle.getAdjacentTriangle(index);
+				// Clockwise triangle: the inside is on the right of each half-edge
+				if (computeOrientation(edgeStart, edgeEnd, position) > 0 && data.twins[e] != InvalidTrIndex)
+				{
+					current = data.twins[e] / 3;
+					break;
+				}
+			}
+
+			// Position is not outside any edge
+			if (i == 3)
+				return current;
+		}
 	}
 
-	// Iterative implementation of RemoveUnusedTriangles
-	void removeOuterPolygonTrianglesImpl(TriangleIterator current, std::stack<TriangleIterator>& stack, const EdgeSet& constrainedEdges)
+	// Returns the half-edge from start to end, or InvalidTrIndex if there is none. In the latter case, crossing is set to the
+	// half-edge opposite to start (in one of its triangles) that the segment start-end intersects, or InvalidTrIndex if no edge is
+	// intersected (e.g. because the segment runs exactly through another vertex).
+	TrIndex findHalfEdge(const TriangulationData& data, TrIndex start, TrIndex end, TrIndex& crossing)
 	{
-		// Flagged triangles have already been passed, skip them
-		if (current->isFlagged())
-			return;
+		sf::Vector2f startPosition = at(data, start);
+		sf::Vector2f endPosition = at(data, end);
+		crossing = InvalidTrIndex;
+
+		// Rotate around start, half-edge by half-edge (the twin of the previous half-edge also starts at start)
+		const TrIndex first = data.vertexEdges[start];
+		TrIndex e = first;
+		do
+		{
+			TrIndex next = nextHalfEdge(e);
+			if (data.corners[next] == end)
+				return e;
 
-		current->setFlagged(true);
+			if (intersection(startPosition, endPosition, at(data, data.corners[next]), at(data, data.corners[nextHalfEdge(next)])))
+				crossing = next;
 
-		OptTriangleIterator adjacent;
-		for (std::size_t i = 0; i < 3; ++i)
-		{
-			if ((adjacent = hasUnusedAdjacent(*current, i, constrainedEdges)).valid)
-				stack.push(adjacent.target);
+			e = data.twins[previousHalfEdge(e)];
 		}
+		while (e != InvalidTrIndex && e != first);
+
+		return InvalidTrIndex;
 	}
 
-	// Removes the triangles that are "unused" (i.e. outside the polygon).
-	// The parameter current refers to any triangle touching at least one boundary point. Starting at this triangle, adjacent triangles
-	// are walked through recursively. When we reach an edge of the polygon (which is always a constrained edge, and vice versa),
-	// we stop here and complete the remaining directions. Finally, all triangles that are outside of the polygon bounds are removed.
-	void removeOuterPolygonTriangles(TriangleList& triangles, TriangleIterator current, const EdgeSet& constrainedEdges)
+	// Collects the edges that intersect the segment start-end in data.crossingEdges, beginning with the half-edge crossing.
+	// Returns false if the segment cannot be traced (it touches a vertex other than its endpoints).
+	bool collectCrossingEdges(TriangulationData& data, TrIndex start, TrIndex end, TrIndex crossing)
 	{
-		std::stack<TriangleIterator> stack;
-		stack.push(current);
+		sf::Vector2f startPosition = at(data, start);
+		sf::Vector2f endPosition = at(data, end);
 
-		while (!stack.empty())
+		data.crossingEdges.clear();
+		for (TrIndex halfEdge = crossing; halfEdge != InvalidTrIndex; )
 		{
-			// get the top element of the stack (next triangle to traverse) and pop it
-			current = stack.top();
-			stack.pop();
+			data.crossingEdges.push_back(std::make_pair(data.corners[halfEdge], data.corners[nextHalfEdge(halfEdge)]));
+
+			// Step into the triangle behind the crossed edge and find out where the segment leaves it
+			TrIndex twin = data.twins[halfEdge];
+			if (twin == InvalidTrIndex)
+				return false;
+
+			TrIndex opposite = data.corners[previousHalfEdge(twin)];
+			if (opposite == end)
+				return true;
+
+			TrIndex candidate1 = nextHalfEdge(twin);
+			TrIndex candidate2 = previousHalfEdge(twin);
 
-			// Call function that may push new triangles onto the stack
-			removeOuterPolygonTrianglesImpl(current, stack, constrainedEdges);
+			if (intersection(startPosition, endPosition, at(data, data.corners[candidate1]), at(data, opposite)))
+				halfEdge = candidate1;
+			else if (intersection(startPosition, endPosition, at(data, opposite), at(data, data.corners[nextHalfEdge(candidate2)])))
+				halfEdge = candidate2;
+			else
+				halfEdge = InvalidTrIndex;
 		}
 
-		// Remove all triangles marked as unused.
-		// We can't erase() during the stack iteration, because triangles' flags are still polled, so the iterators must be valid.
-		triangles.remove_if(std::mem_fn(&AdvancedTriangle::isFlagged));
+		return false;
 	}
 
-	// Removes all triangles that are not directly required for the resulting triangulation (algorithm-supporting data).
-	// In case that a polygon is triangulated, all triangles at the outside of the polygon are removed.
-	void removeUnusedTriangles(TriangleList& triangles, const AdvancedTriangle& boundaryTriangle, const EdgeSet& constrainedEdges, bool limitToPolygon)
+	// Inserts a constrained edge that is missing in the triangulation, by flipping the edges that cross it (Sloan's algorithm).
+	// Edges that cannot be flipped yet (because their quadrilateral is not convex) are postponed until the neighborhood has changed.
+	// Afterwards, the Delaunay condition is restored around the new edges; the constrained edge itself blocks flips across it.
+	void recoverConstrainedEdge(TriangulationData& data, TrIndex start, TrIndex end)
 	{
-		for (TriangleList::iterator itr = triangles.begin(); itr != triangles.end(); )
+		TrIndex crossing;
+		if (findHalfEdge(data, start, end, crossing) != InvalidTrIndex || crossing == InvalidTrIndex)
+			return;
+
+		if (!collectCrossingEdges(data, start, end, crossing))
+			return;
+
+		sf::Vector2f startPosition = at(data, start);
+		sf::Vector2f endPosition = at(data, end);
+
+		std::vector<std::pair<TrIndex, TrIndex>>& queue = data.crossingEdges;
+		std::size_t postponed = 0;
+		for (std::size_t head = 0; head < queue.size(); ++head)
+		{
+			std::pair<TrIndex, TrIndex> edge = queue[head];
+
+			TrIndex unused;
+			TrIndex halfEdge = findHalfEdge(data, edge.first, edge.second, unused);
+			if (halfEdge == InvalidTrIndex || data.twins[halfEdge] == InvalidTrIndex)
+				continue;
+
+			// Only flip if the quadrilateral is strictly convex, i.e. the other diagonal intersects the edge
+			TrIndex c = data.corners[previousHalfEdge(halfEdge)];
+			TrIndex d = data.corners[previousHalfEdge(data.twins[halfEdge])];
+
+			if (!intersection(at(data, edge.first), at(data, edge.second), at(data, c), at(data, d)))
+			{
+				// Give up if none of the queued edges can be flipped anymore
+				if (++postponed > queue.size() - head)
+					break;
+
+				queue.push_back(edge);
+				continue;
+			}
+
+			postponed = 0;
+			flipEdge(data, halfEdge);
+
+			// The new edge may still cross the constrained edge
+			if (intersection(startPosition, endPosition, at(data, c), at(data, d)))
+				queue.push_back(std::make_pair(c, d));
+		}
+
+		queue.clear();
+		restoreDelaunay(data);
+	}
+
+	// Sets the initial point positions so that the triangle of dummy vertices includes all other vertices.
+	// Like this, we can start the algorithm seamlessly.
+	void setBoundaryPositions(TriangulationData& data)
+	{
+		// Find maximal coordinate in any direction (at least boundaryExtent, which is 1 unless several triangulations must agree)
+		float maxCoord = data.boundaryExtent;
+		for (std::size_t i = BoundaryVertexCount; i < data.positions.size(); ++i)
+		{
+			sf::Vector2f position = data.positions[i];
+
+			maxCoord = std::max(maxCoord, std::abs(position.x));
+			maxCoord = std::max(maxCoord, std::abs(position.y));
+		}
+
+		// Reduce probability to have a 3 collinear points (which can't be triangulated) by slightly moving boundary points. Take arbitrary value...
+		const float epsilon = 0.000372f;
+
+		// Overwrite 3 dummy vertices so that the resulting triangle certainly surrounds all other vertices.
+		maxCoord *= 4.f;
+		data.positions[0] = sf::Vector2f(epsilon, maxCoord-epsilon);
+		data.positions[1] = sf::Vector2f(maxCoord+epsilon, -epsilon);
+		data.positions[2] = sf::Vector2f(-maxCoord-epsilon, -maxCoord+epsilon);
+	}
+
+	// Removes the triangles that are outside the polygon.
+	// The parameter start refers to any triangle touching at least one boundary point. Starting at this triangle, adjacent triangles
+	// are walked through. When we reach an edge of the polygon (which is always a constrained edge, and vice versa), we stop here and
+	// complete the remaining directions.
+	void markOuterPolygonTriangles(TriangulationData& data, TrIndex start)
+	{
+		std::vector<TrIndex>& stack = data.pendingEdges;
+		stack.push_back(start);
+
+		while (!stack.empty())
+		{
+			TrIndex current = stack.back();
+			stack.pop_back();
+
+			// Marked triangles have already been passed, skip them
+			if (data.removed[current])
+				continue;
+
+			data.removed[current] = true;
+
+			for (TrIndex e = 3*current; e < 3*current+3; ++e)
+			{
+				TrIndex twin = data.twins[e];
+
+				if (twin != InvalidTrIndex && !isEdgeConstrained(data, data.corners[e], data.corners[nextHalfEdge(e)]))
+					stack.push_back(twin / 3);
+			}
+		}
+	}
+
+	// Removes all triangles that are not directly required for the resulting triangulation (algorithm-supporting data).
+	// In case that a polygon is triangulated, all triangles at the outside of the polygon are removed.
+	void removeUnusedTriangles(TriangulationData& data, bool limitToPolygon)
+	{
+		const TrIndex nbTriangles = static_cast<TrIndex>(data.firstVertices.size());
+		data.removed.assign(nbTriangles, false);
+
+		for (TrIndex t = 0; t < nbTriangles; ++t)
 		{
 			// If the current triangle is located at the boundary (touches one of the boundary corners)
-			if (has1Of3Corners(*itr, boundaryTriangle))
+			if (isBoundary(data.corners[3*t]) || isBoundary(data.corners[3*t+1]) || isBoundary(data.corners[3*t+2]))
 			{
 				// When we just want to triangulate the inside of a polygon, we must cut off all outer triangles, beginning
 				// at any boundary-touching triangle.
 				if (limitToPolygon)
-					return removeOuterPolygonTriangles(triangles, itr, constrainedEdges);
+				{
+					markOuterPolygonTriangles(data, t);
+					break;
+				}
 
 				// Otherwise, only the very outer triangles (those touching the boundary vertices) must be removed
-				else
-					itr = triangles.erase(itr);
+				data.removed[t] = true;
+			}
+		}
+
+		// Compact the remaining triangles; new index of each old triangle is stored in firstVertices (no longer needed).
+		// Vertices that are not part of any remaining triangle have no half-edge anymore.
+		std::fill(data.vertexEdges.begin(), data.vertexEdges.end(), InvalidTrIndex);
+		std::vector<TrIndex>& newIndices = data.firstVertices;
+		TrIndex kept = 0;
+		for (TrIndex t = 0; t < nbTriangles; ++t)
+			newIndices[t] = data.removed[t] ? InvalidTrIndex : kept++;
+
+		for (TrIndex t = 0; t < nbTriangles; ++t)
+		{
+			if (newIndices[t] == InvalidTrIndex)
+				continue;
+
+			for (TrIndex i = 0; i < 3; ++i)
+			{
+				TrIndex twin = data.twins[3*t+i];
+				if (twin != InvalidTrIndex)
+					twin = (newIndices[twin / 3] == InvalidTrIndex) ? InvalidTrIndex : 3 * newIndices[twin / 3] + twin % 3;
+
+				data.corners[3*newIndices[t]+i] = data.corners[3*t+i];
+				data.twins[3*newIndices[t]+i] = twin;
+				data.vertexEdges[data.corners[3*t+i]] = 3*newIndices[t]+i;
+			}
+		}
+
+		data.corners.resize(3 * kept);
+		data.twins.resize(3 * kept);
+		data.firstVertices.clear();
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	TriangulationData::TriangulationData()
+	: pointLocation(WalkingLocation)
+	, boundaryExtent(1.f)
+	{
+	}
+
+	ParallelTriangulationData::ParallelTriangulationData()
+	: threadCount(1)
+	, bounds()
+	{
+	}
+
+	void resetTriangulation(TriangulationData& data)
+	{
+		data.positions.clear();
+		data.constrainedEdges.clear();
+		data.userVertices.clear();
+		data.importantVertices.clear();
+		data.inputIndices.clear();
+		data.corners.clear();
+		data.twins.clear();
+		data.vertexEdges.clear();
+		data.firstVertices.clear();
+		data.nextVertices.clear();
+		data.vertexTriangles.clear();
+		data.pendingEdges.clear();
+		data.insertionOrder.clear();
+		data.hilbertKeys.clear();
+		data.crossingEdges.clear();
+		data.removed.clear();
+		data.neighborVertices.clear();
+		data.edgeTree.segments.clear();
+		data.edgeTree.boxes.clear();
+		data.edgeTree.levelBegins.clear();
+
+		// Add boundary vertices; the final positions are set later, when all vertices are known
+		data.positions.resize(BoundaryVertexCount);
+	}
+
+	void computeTriangulation(TriangulationData& data, bool limitToPolygon)
+	{
+		assert(data.positions.size() >= BoundaryVertexCount);
+		assert(data.positions.size() <= InvalidTrIndex / 6);
+
+		const TrIndex nbVertices = static_cast<TrIndex>(data.positions.size());
+
+		setBoundaryPositions(data);
+		normalizeConstrainedEdges(data);
+		buildEdgeTree(data);
+
+		// Each inserted vertex adds two triangles to the initial one
+		const std::size_t nbTriangles = 2 * (nbVertices - BoundaryVertexCount) + 1;
+		data.corners.clear();
+		data.twins.clear();
+		data.firstVertices.clear();
+		data.corners.reserve(3 * nbTriangles);
+		data.twins.reserve(3 * nbTriangles);
+		data.firstVertices.reserve(nbTriangles);
+		data.vertexEdges.assign(nbVertices, InvalidTrIndex);
+		data.nextVertices.assign(nbVertices, InvalidTrIndex);
+		data.vertexTriangles.assign(nbVertices, InvalidTrIndex);
+
+		// First triangle is the one containing the three boundary vertices; all other vertices are inside it
+		TrIndex first = appendTriangle(data);
+		setTriangle(data, first, 0, 1, 2);
+
+		if (data.pointLocation == WalkingLocation)
+		{
+			// Locate each vertex by walking from the previous one, in spatially coherent order
+			computeInsertionOrder(data);
+
+			std::minstd_rand random;
+			TrIndex last = first;
+			AURORA_FOREACH(TrIndex vertex, data.insertionOrder)
+			{
+				last = locateTriangle(data, at(data, vertex), last, random);
+				data.vertexTriangles[vertex] = last;
+
+				insertPoint(data, vertex);
 			}
+		}
+		else
+		{
+			// All vertices are inside the first triangle; their lists are split up with every insertion
+			for (TrIndex vertex = nbVertices; vertex-- > BoundaryVertexCount; )
+				pushRemainingVertex(data, first, vertex);
+
+			// Insert each vertex in the order of collation (constrained edges' vertices first)
+			for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices; ++vertex)
+				insertPoint(data, vertex);
+		}
+
+		// Insert constrained edges that the local edge flips during insertion did not establish
+		AURORA_FOREACH(const auto& edge, data.constrainedEdges)
+			recoverConstrainedEdge(data, edge.first, edge.second);
+
+		// Remove triangles that are not contained in the final triangulation
+		removeUnusedTriangles(data, limitToPolygon);
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Minimal number of vertices per strip, below which a parallel triangulation does not pay off
+	const TrIndex MinVerticesPerPart = 16384;
 
-			// Triangle is retained, continue
+	// Calls function(task, thread) for each task in [0, taskCount[, distributed over threadCount threads (including the calling one,
+	// which has the index 0). The thread index allows each thread to use its own scratch memory.
+	template <typename Function>
+	void runParallel(std::size_t taskCount, unsigned int threadCount, Function function)
+	{
+		std::atomic<std::size_t> nextTask(0);
+		auto worker = [&] (unsigned int thread)
+		{
+			for (std::size_t task = nextTask++; task < taskCount; task = nextTask++)
+				function(task, thread);
+		};
+
+		std::vector<std::thread> threads;
+		for (unsigned int i = 1; i < threadCount && i < taskCount; ++i)
+			threads.push_back(std::thread(worker, i));
+
+		worker(0);
+		AURORA_FOREACH(std::thread& thread, threads)
+			thread.join();
+	}
+
+	// Checks whether a circle lies strictly between the neighbors of the given strip (and inside the bounds of all vertices).
+	// A triangle of the strip with such a circumcircle contains no vertex of any strip, so it is final.
+	bool isInsidePart(const ParallelTriangulationData& parallel, std::size_t part, Circle circle)
+	{
+		if (circle.squaredRadius == InfiniteRadius)
+			return false;
+
+		const float radius = std::sqrt(circle.squaredRadius);
+		const float left = (part == 0) ? parallel.bounds.min.x : parallel.parts[part-1].maxX;
+		const float right = (part + 1 == parallel.parts.size()) ? parallel.bounds.max.x : parallel.parts[part+1].minX;
+
+		return circle.midPoint.x - radius > left
+			&& circle.midPoint.x + radius < right
+			&& circle.midPoint.y - radius > parallel.bounds.min.y
+			&& circle.midPoint.y + radius < parallel.bounds.max.y;
+	}
+
+	// Copies a strip of vertices into its own triangulation and computes it
+	void triangulatePart(const TriangulationData& data, TriangulationPart& part,
+		std::vector<TrIndex>::const_iterator begin, std::vector<TrIndex>::const_iterator end, float boundaryExtent)
+	{
+		resetTriangulation(part.data);
+		part.data.boundaryExtent = boundaryExtent;
+		part.minX = std::numeric_limits<float>::max();
+		part.maxX = -std::numeric_limits<float>::max();
+
+		for (; begin != end; ++begin)
+		{
+			const sf::Vector2f position = at(data, *begin);
+			part.data.positions.push_back(position);
+			part.data.inputIndices.push_back(*begin);
+			part.minX = std::min(part.minX, position.x);
+			part.maxX = std::max(part.maxX, position.x);
+		}
+
+		computeTriangulation(part.data, false);
+	}
+
+	// Returns the vertex index in the whole triangulation of the corner at which a strip's half-edge starts
+	TrIndex getPartCorner(const TriangulationPart& part, TrIndex halfEdge)
+	{
+		return part.data.inputIndices[part.data.corners[halfEdge] - BoundaryVertexCount];
+	}
+
+	// Splits a strip's triangles into final ones and those whose vertices have to be triangulated again
+	void classifyPartTriangles(ParallelTriangulationData& parallel, std::size_t index)
+	{
+		TriangulationPart& part = parallel.parts[index];
+		const TriangulationData& local = part.data;
+		const TrIndex nbTriangles = static_cast<TrIndex>(local.corners.size() / 3);
+
+		part.finalTriangles.resize(nbTriangles);
+		part.seamVertices.clear();
+		part.finalCount = 0;
+
+		for (TrIndex t = 0; t < nbTriangles; ++t)
+		{
+			if (isInsidePart(parallel, index, computeCircumcircle(local, t)))
+			{
+				part.finalTriangles[t] = part.finalCount++;
+			}
 			else
 			{
-				++itr;
+				part.finalTriangles[t] = InvalidTrIndex;
+				for (TrIndex e = 3*t; e < 3*t+3; ++e)
+					part.seamVertices.push_back(getPartCorner(part, e));
+			}
+
+			// Vertices on the strip's border have neighbors outside the strip
+			for (TrIndex e = 3*t; e < 3*t+3; ++e)
+			{
+				if (local.twins[e] == InvalidTrIndex)
+				{
+					part.seamVertices.push_back(getPartCorner(part, e));
+					part.seamVertices.push_back(getPartCorner(part, nextHalfEdge(e)));
+				}
+			}
+		}
+	}
+
+	// Copies a strip's final triangles to their place in the whole triangulation. Links to non-final triangles are left open.
+	void copyFinalTriangles(TriangulationData& data, const TriangulationPart& part)
+	{
+		const std::vector<TrIndex>& localTwins = part.data.twins;
+
+		for (TrIndex t = 0; t < part.finalTriangles.size(); ++t)
+		{
+			if (part.finalTriangles[t] == InvalidTrIndex)
+				continue;
+
+			const TrIndex target = part.firstFinal + part.finalTriangles[t];
+			for (TrIndex i = 0; i < 3; ++i)
+			{
+				const TrIndex twin = localTwins[3*t+i];
+				const bool finalTwin = (twin != InvalidTrIndex && part.finalTriangles[twin / 3] != InvalidTrIndex);
+
+				data.corners[3*target+i] = getPartCorner(part, 3*t+i);
+				data.twins[3*target+i] = finalTwin ? 3 * (part.firstFinal + part.finalTriangles[twin / 3]) + twin % 3 : InvalidTrIndex;
 			}
 		}
 	}
 
-} // namespace detail
+	// Returns the half-edge from start to end on the outline of the final triangles, or InvalidTrIndex if there is none
+	TrIndex findOutlineHalfEdge(const TriangulationData& data, const ParallelTriangulationData& parallel, TrIndex start, TrIndex end)
+	{
+		auto range = std::equal_range(parallel.outline.begin(), parallel.outline.end(), std::make_pair(start, InvalidTrIndex),
+			[] (const std::pair<TrIndex, TrIndex>& lhs, const std::pair<TrIndex, TrIndex>& rhs) { return lhs.first < rhs.first; });
+
+		for (; range.first != range.second; ++range.first)
+		{
+			if (data.corners[nextHalfEdge(range.first->second)] == end)
+				return range.first->second;
+		}
+
+		return InvalidTrIndex;
+	}
+
+	// Returns the vertex index in the whole triangulation of the corner at which a seam half-edge starts
+	TrIndex getSeamCorner(const ParallelTriangulationData& parallel, TrIndex halfEdge)
+	{
+		return parallel.seam.inputIndices[parallel.seam.corners[halfEdge] - BoundaryVertexCount];
+	}
+
+	// Marks the seam triangles that lie in the region covered by the final triangles. A seam triangle with a half-edge on the
+	// outline, directed like the final triangle's one, lies on the inner side; from there, the marking spreads until it reaches
+	// the outline again, which consists of constrained edges in the seam triangulation.
+	void markFinalRegionTriangles(const TriangulationData& data, ParallelTriangulationData& parallel)
+	{
+		TriangulationData& seam = parallel.seam;
+		std::vector<TrIndex>& stack = seam.pendingEdges;
+		seam.removed.assign(seam.corners.size() / 3, false);
+
+		for (TrIndex e = 0; e < seam.corners.size(); ++e)
+		{
+			if (findOutlineHalfEdge(data, parallel, getSeamCorner(parallel, e), getSeamCorner(parallel, nextHalfEdge(e))) != InvalidTrIndex)
+				stack.push_back(e / 3);
+		}
+
+		while (!stack.empty())
+		{
+			const TrIndex t = stack.back();
+			stack.pop_back();
+
+			if (seam.removed[t])
+				continue;
+
+			seam.removed[t] = true;
+			for (TrIndex e = 3*t; e < 3*t+3; ++e)
+			{
+				const bool onOutline = findOutlineHalfEdge(data, parallel,
+					getSeamCorner(parallel, e), getSeamCorner(parallel, nextHalfEdge(e))) != InvalidTrIndex;
+
+				if (!onOutline && seam.twins[e] != InvalidTrIndex)
+					stack.push_back(seam.twins[e] / 3);
+			}
+		}
+	}
+
+	// Appends the seam triangles outside the final region, and links them to each other and to the final triangles
+	void appendSeamTriangles(TriangulationData& data, ParallelTriangulationData& parallel)
+	{
+		const TriangulationData& seam = parallel.seam;
+		std::vector<TrIndex>& newIndices = parallel.seamTriangles;
+		TrIndex next = static_cast<TrIndex>(data.corners.size() / 3);
+
+		newIndices.resize(seam.removed.size());
+		for (TrIndex t = 0; t < seam.removed.size(); ++t)
+			newIndices[t] = seam.removed[t] ? InvalidTrIndex : next++;
+
+		data.corners.resize(3 * next);
+		data.twins.resize(3 * next);
+
+		for (TrIndex t = 0; t < seam.removed.size(); ++t)
+		{
+			if (seam.removed[t])
+				continue;
+
+			for (TrIndex i = 0; i < 3; ++i)
+			{
+				const TrIndex e = 3 * newIndices[t] + i;
+				const TrIndex twin = seam.twins[3*t+i];
+				data.corners[e] = getSeamCorner(parallel, 3*t+i);
+
+				if (twin != InvalidTrIndex && !seam.removed[twin / 3])
+				{
+					data.twins[e] = 3 * newIndices[twin / 3] + twin % 3;
+				}
+				else
+				{
+					// The edge borders the final region: link with the opposite half-edge on the outline
+					const TrIndex outlineEdge = findOutlineHalfEdge(data, parallel,
+						getSeamCorner(parallel, nextHalfEdge(3*t+i)), getSeamCorner(parallel, 3*t+i));
+
+					data.twins[e] = outlineEdge;
+					if (outlineEdge != InvalidTrIndex)
+						data.twins[outlineEdge] = e;
+				}
+			}
+		}
+	}
+
+	void computeParallelTriangulation(TriangulationData& data, ParallelTriangulationData& parallel)
+	{
+		const TrIndex nbVertices = static_cast<TrIndex>(data.positions.size()) - BoundaryVertexCount;
+		const unsigned int threadCount = (parallel.threadCount != 0) ? parallel.threadCount : std::max(1u, std::thread::hardware_concurrency());
+		const TrIndex nbParts = std::min<TrIndex>(threadCount, nbVertices / MinVerticesPerPart);
+
+		// Small vertex sets are triangulated directly
+		if (nbParts <= 1)
+			return computeTriangulation(data, false);
+
+		// Determine bounds and the boundary triangle that the serial algorithm would use, so that all strips agree with it
+		parallel.bounds = emptyBox();
+		float boundaryExtent = 1.f;
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices + BoundaryVertexCount; ++vertex)
+		{
+			const sf::Vector2f position = at(data, vertex);
+			extendBox(parallel.bounds, position);
+			boundaryExtent = std::max(boundaryExtent, std::max(std::abs(position.x), std::abs(position.y)));
+		}
+
+		// Partition vertices into strips of equal size, ordered by x (ties broken by y and index)
+		std::vector<TrIndex>& order = data.insertionOrder;
+		order.resize(nbVertices);
+		for (TrIndex i = 0; i < nbVertices; ++i)
+			order[i] = i + BoundaryVertexCount;
+
+		auto compareX = [&data] (TrIndex lhs, TrIndex rhs)
+		{
+			const sf::Vector2f l = at(data, lhs);
+			const sf::Vector2f r = at(data, rhs);
+			return l.x < r.x || (l.x == r.x && (l.y < r.y || (l.y == r.y && lhs < rhs)));
+		};
+
+		for (TrIndex part = 1; part < nbParts; ++part)
+		{
+			const std::size_t previousSplit = static_cast<std::size_t>(part - 1) * nbVertices / nbParts;
+			const std::size_t split = static_cast<std::size_t>(part) * nbVertices / nbParts;
+			std::nth_element(order.begin() + previousSplit, order.begin() + split, order.end(), compareX);
+		}
+
+		// Triangulate strips concurrently, then classify their triangles (which requires the extent of neighbor strips)
+		parallel.parts.resize(nbParts);
+		runParallel(nbParts, threadCount, [&] (std::size_t part, unsigned int)
+		{
+			triangulatePart(data, parallel.parts[part],
+				order.begin() + part * nbVertices / nbParts,
+				order.begin() + (part + 1) * nbVertices / nbParts, boundaryExtent);
+		});
+
+		runParallel(nbParts, threadCount, [&] (std::size_t part, unsigned int)
+		{
+			classifyPartTriangles(parallel, part);
+		});
+
+		// Place the final triangles one strip after another, and mark the vertices of the remaining ones
+		TrIndex nbFinal = 0;
+		parallel.seamIndices.assign(nbVertices, InvalidTrIndex);
+
+		AURORA_FOREACH(TriangulationPart& part, parallel.parts)
+		{
+			part.firstFinal = nbFinal;
+			nbFinal += part.finalCount;
+
+			AURORA_FOREACH(TrIndex vertex, part.seamVertices)
+				parallel.seamIndices[vertex - BoundaryVertexCount] = 0;
+		}
+
+		data.corners.resize(3 * nbFinal);
+		data.twins.resize(3 * nbFinal);
+		runParallel(nbParts, threadCount, [&] (std::size_t part, unsigned int)
+		{
+			copyFinalTriangles(data, parallel.parts[part]);
+		});
+
+		// The outline of the final region consists of the half-edges without twin
+		parallel.outline.clear();
+		for (TrIndex e = 0; e < data.corners.size(); ++e)
+		{
+			if (data.twins[e] == InvalidTrIndex)
+				parallel.outline.push_back(std::make_pair(data.corners[e], e));
+		}
+
+		std::sort(parallel.outline.begin(), parallel.outline.end());
+
+		// Triangulate the seam vertices once more, with the outline as constrained edges
+		TriangulationData& seam = parallel.seam;
+		resetTriangulation(seam);
+		seam.boundaryExtent = boundaryExtent;
+
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices + BoundaryVertexCount; ++vertex)
+		{
+			TrIndex& seamIndex = parallel.seamIndices[vertex - BoundaryVertexCount];
+			if (seamIndex != InvalidTrIndex)
+			{
+				seamIndex = static_cast<TrIndex>(seam.positions.size());
+				seam.positions.push_back(at(data, vertex));
+				seam.inputIndices.push_back(vertex);
+			}
+		}
+
+		AURORA_FOREACH(const auto& outlineEdge, parallel.outline)
+		{
+			seam.constrainedEdges.push_back(std::make_pair(
+				parallel.seamIndices[data.corners[outlineEdge.second] - BoundaryVertexCount],
+				parallel.seamIndices[data.corners[nextHalfEdge(outlineEdge.second)] - BoundaryVertexCount]));
+		}
+
+		computeTriangulation(seam, false);
+
+		// Complete the triangulation with the seam triangles outside the final region
+		markFinalRegionTriangles(data, parallel);
+		appendSeamTriangles(data, parallel);
+
+		data.vertexEdges.assign(data.positions.size(), InvalidTrIndex);
+		for (TrIndex e = 0; e < data.corners.size(); ++e)
+			data.vertexEdges[data.corners[e]] = e;
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	void computeBatchTriangulation(BatchTriangulationData& batch, unsigned int threadCount, BatchCollateFunction collate)
+	{
+		const std::size_t nbPolygons = batch.polygons.size();
+		if (threadCount == 0)
+			threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+		// Workers keep their scratch memory across batches; only their results are discarded
+		if (batch.workers.size() < threadCount)
+			batch.workers.resize(threadCount);
+
+		AURORA_FOREACH(BatchWorker& worker, batch.workers)
+			worker.indices.clear();
+
+		batch.results.resize(nbPolygons);
+		runParallel(nbPolygons, threadCount, [&] (std::size_t polygon, unsigned int thread)
+		{
+			BatchWorker& worker = batch.workers[thread];
+			TriangulationData& data = worker.data;
+
+			resetTriangulation(data);
+			collate(data, batch.polygons[polygon]);
+			computeTriangulation(data, true);
+
+			BatchPolygonResult& result = batch.results[polygon];
+			result.worker = thread;
+			result.begin = static_cast<TrIndex>(worker.indices.size());
+
+			AURORA_FOREACH(TrIndex corner, data.corners)
+				worker.indices.push_back(data.inputIndices[corner - BoundaryVertexCount]);
+
+			result.end = static_cast<TrIndex>(worker.indices.size());
+		});
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Returns true if the vertex is part of the dynamic triangulation (removed vertices have no half-edge).
+	bool isVertexAlive(const TriangulationData& data, TrIndex vertex)
+	{
+		return data.vertexEdges[vertex] != InvalidTrIndex;
+	}
+
+	// Returns the greatest absolute coordinate of a position.
+	float getMaxCoordinate(sf::Vector2f position)
+	{
+		return std::max(std::abs(position.x), std::abs(position.y));
+	}
+
+	// Removes an edge from the sorted constrained edges, if it is contained.
+	void eraseConstrainedEdge(TriangulationData& data, TrIndex start, TrIndex end)
+	{
+		std::pair<TrIndex, TrIndex> edge(std::min(start, end), std::max(start, end));
+
+		auto found = std::lower_bound(data.constrainedEdges.begin(), data.constrainedEdges.end(), edge);
+		if (found != data.constrainedEdges.end() && *found == edge)
+			data.constrainedEdges.erase(found);
+	}
+
+	// Chooses the triangle from which the walk towards position begins: the one of the closest vertex among the hint and about n^(1/3)
+	// random samples (jump-and-walk). Like this, also positions far away from the previous edit are found in sublinear expected time.
+	TrIndex findWalkStart(const TriangulationData& data, sf::Vector2f position, TrIndex hint, std::minstd_rand& random)
+	{
+		const TrIndex nbVertices = static_cast<TrIndex>(data.positions.size());
+
+		TrIndex closest = InvalidTrIndex;
+		float closestDistance = std::numeric_limits<float>::max();
+
+		if (hint != InvalidTrIndex && isVertexAlive(data, hint))
+		{
+			closest = hint;
+			closestDistance = squaredLength(at(data, hint) - position);
+		}
+
+		if (nbVertices > BoundaryVertexCount)
+		{
+			const TrIndex nbSamples = static_cast<TrIndex>(std::cbrt(static_cast<float>(nbVertices)));
+			for (TrIndex i = 0; i < nbSamples; ++i)
+			{
+				TrIndex vertex = BoundaryVertexCount + random() % (nbVertices - BoundaryVertexCount);
+				float distance = squaredLength(at(data, vertex) - position);
+
+				if (isVertexAlive(data, vertex) && distance < closestDistance)
+				{
+					closest = vertex;
+					closestDistance = distance;
+				}
+			}
+		}
+
+		// Without any vertex to start from, begin at an arbitrary triangle
+		return (closest != InvalidTrIndex) ? data.vertexEdges[closest] / 3 : 0;
+	}
+
+	// Removes triangle t by moving the last triangle to its place. The half-edges of t must no longer be referenced by other triangles.
+	void removeTriangle(TriangulationData& data, TrIndex t)
+	{
+		const TrIndex last = static_cast<TrIndex>(data.firstVertices.size()) - 1;
+
+		if (t != last)
+		{
+			for (TrIndex i = 0; i < 3; ++i)
+			{
+				TrIndex corner = data.corners[3*last+i];
+
+				data.corners[3*t+i] = corner;
+				linkHalfEdges(data, 3*t+i, data.twins[3*last+i]);
+
+				if (data.vertexEdges[corner] == 3*last+i)
+					data.vertexEdges[corner] = 3*t+i;
+			}
+		}
+
+		data.corners.resize(3 * last);
+		data.twins.resize(3 * last);
+		data.firstVertices.pop_back();
+	}
+
+	// Returns the number of triangles around a non-boundary vertex.
+	TrIndex countIncidentTriangles(const TriangulationData& data, TrIndex vertex)
+	{
+		TrIndex count = 0;
+
+		const TrIndex first = data.vertexEdges[vertex];
+		TrIndex e = first;
+		do
+		{
+			++count;
+			e = data.twins[previousHalfEdge(e)];
+		}
+		while (e != first);
+
+		return count;
+	}
+
+	// Flips one of the edges at a non-boundary vertex away, so that the vertex loses one triangle. The new edge is stored in
+	// data.crossingEdges. A flip that leaves a flat triangle at the vertex (because the vertex lies on the new edge) is only chosen if
+	// there is no other option; the flat triangle disappears when the last three triangles are merged. Returns false if no edge can
+	// be flipped, which is only possible due to rounding errors.
+	bool flipIncidentEdge(TriangulationData& data, TrIndex vertex)
+	{
+		sf::Vector2f position = at(data, vertex);
+		TrIndex chosen = InvalidTrIndex;
+		TrIndex degenerate = InvalidTrIndex;
+
+		const TrIndex first = data.vertexEdges[vertex];
+		TrIndex e = first;
+		do
+		{
+			// The triangles (vertex,b,c) and (b,vertex,d) become (vertex,d,c) and (b,c,d), see flipEdge()
+			sf::Vector2f b = at(data, data.corners[nextHalfEdge(e)]);
+			sf::Vector2f c = at(data, data.corners[previousHalfEdge(e)]);
+			sf::Vector2f d = at(data, data.corners[previousHalfEdge(data.twins[e])]);
+
+			int outer = computeOrientation(b, c, d);
+			int inner = computeOrientation(position, d, c);
+
+			if (outer < 0 && inner < 0)
+				chosen = e;
+			else if (outer < 0 && inner == 0 && degenerate == InvalidTrIndex)
+				degenerate = e;
+
+			e = data.twins[previousHalfEdge(e)];
+		}
+		while (chosen == InvalidTrIndex && e != first);
+
+		if (chosen == InvalidTrIndex)
+			chosen = degenerate;
+
+		if (chosen == InvalidTrIndex)
+			return false;
+
+		data.crossingEdges.push_back(std::make_pair(data.corners[previousHalfEdge(chosen)], data.corners[previousHalfEdge(data.twins[chosen])]));
+		flipEdge(data, chosen);
+
+		return true;
+	}
+
+	// Replaces the three triangles around a non-boundary vertex by a single one, which no longer contains the vertex.
+	void mergeIncidentTriangles(TriangulationData& data, TrIndex vertex)
+	{
+		// Half-edges from the vertex to its neighbors, in clockwise order (see findHalfEdge())
+		TrIndex edges[3];
+		edges[0] = data.vertexEdges[vertex];
+		edges[1] = data.twins[previousHalfEdge(edges[0])];
+		edges[2] = data.twins[previousHalfEdge(edges[1])];
+		assert(data.twins[previousHalfEdge(edges[2])] == edges[0]);
+
+		// The outer half-edges of the triangles form the new one, which is clockwise as well
+		TrIndex outerTwins[3];
+		TrIndex triangles[3];
+		for (TrIndex i = 0; i < 3; ++i)
+		{
+			outerTwins[i] = data.twins[nextHalfEdge(edges[i])];
+			triangles[i] = edges[i] / 3;
+		}
+
+		// Keep the triangle with the smallest index, so that removing the others does not move it
+		std::sort(triangles, triangles + 3);
+		const TrIndex kept = triangles[0];
+
+		setTriangle(data, kept, data.corners[nextHalfEdge(edges[0])], data.corners[nextHalfEdge(edges[1])], data.corners[nextHalfEdge(edges[2])]);
+		for (TrIndex i = 0; i < 3; ++i)
+			linkHalfEdges(data, 3*kept+i, outerTwins[i]);
+
+		data.vertexEdges[vertex] = InvalidTrIndex;
+		removeTriangle(data, triangles[2]);
+		removeTriangle(data, triangles[1]);
+	}
+
+	// Triangulates the vertices in data.insertionOrder (in this order) and recovers the constrained edges. In contrast to
+	// computeTriangulation(), the triangles at the boundary vertices are kept.
+	void triangulateWithBoundary(TriangulationData& data)
+	{
+		const TrIndex nbVertices = static_cast<TrIndex>(data.positions.size());
+
+		data.corners.clear();
+		data.twins.clear();
+		data.firstVertices.clear();
+		data.pendingEdges.clear();
+		data.vertexEdges.assign(nbVertices, InvalidTrIndex);
+		data.nextVertices.assign(nbVertices, InvalidTrIndex);
+		data.vertexTriangles.assign(nbVertices, InvalidTrIndex);
+
+		setBoundaryPositions(data);
+		setTriangle(data, appendTriangle(data), 0, 1, 2);
+
+		std::minstd_rand random;
+		TrIndex last = 0;
+		AURORA_FOREACH(TrIndex vertex, data.insertionOrder)
+		{
+			last = locateTriangle(data, at(data, vertex), last, random);
+			data.vertexTriangles[vertex] = last;
+
+			insertPoint(data, vertex);
+		}
+
+		AURORA_FOREACH(const auto& edge, data.constrainedEdges)
+			recoverConstrainedEdge(data, edge.first, edge.second);
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	void rebuildDynamicTriangulation(TriangulationData& data)
+	{
+		const TrIndex nbVertices = static_cast<TrIndex>(data.positions.size());
+		data.vertexEdges.resize(nbVertices, InvalidTrIndex);
+
+		// Collect the vertices that are alive in BRIO order, and make sure the boundary triangle covers them
+		computeInsertionOrder(data);
+		data.insertionOrder.erase(std::remove_if(data.insertionOrder.begin(), data.insertionOrder.end(),
+			[&data] (TrIndex vertex) { return !isVertexAlive(data, vertex); }), data.insertionOrder.end());
+
+		AURORA_FOREACH(TrIndex vertex, data.insertionOrder)
+			data.boundaryExtent = std::max(data.boundaryExtent, getMaxCoordinate(at(data, vertex)));
+
+		triangulateWithBoundary(data);
+	}
+
+	void insertDynamicVertex(TriangulationData& data, TrIndex vertex, TrIndex hint)
+	{
+		assert(!isBoundary(vertex) && !isVertexAlive(data, vertex));
+
+		// If the boundary triangle does not cover the vertex, enlarge it. Doubling the extent keeps the amortized cost of rebuilds low.
+		sf::Vector2f position = at(data, vertex);
+		if (getMaxCoordinate(position) > data.boundaryExtent)
+		{
+			data.boundaryExtent = 2.f * getMaxCoordinate(position);
+			rebuildDynamicTriangulation(data);
+		}
+
+		data.nextVertices.resize(data.positions.size(), InvalidTrIndex);
+		data.vertexTriangles.resize(data.positions.size(), InvalidTrIndex);
+
+		std::minstd_rand random(vertex);
+		TrIndex start = findWalkStart(data, position, hint, random);
+		data.vertexTriangles[vertex] = locateTriangle(data, position, start, random);
+
+		insertPoint(data, vertex);
+	}
+
+	void removeDynamicVertex(TriangulationData& data, TrIndex vertex)
+	{
+		assert(!isBoundary(vertex) && isVertexAlive(data, vertex));
+
+		// Drop the constrained edges at the vertex, and remember the outline of its triangles (the hole to re-triangulate)
+		data.crossingEdges.clear();
+
+		const TrIndex first = data.vertexEdges[vertex];
+		TrIndex e = first;
+		do
+		{
+			TrIndex neighbor = data.corners[nextHalfEdge(e)];
+
+			eraseConstrainedEdge(data, vertex, neighbor);
+			data.crossingEdges.push_back(std::make_pair(neighbor, data.corners[previousHalfEdge(e)]));
+
+			e = data.twins[previousHalfEdge(e)];
+		}
+		while (e != first);
+
+		// Flip edges away until three triangles remain, and merge those. Should no edge be flippable, rebuild without the vertex.
+		for (TrIndex degree = countIncidentTriangles(data, vertex); degree > 3; --degree)
+		{
+			if (!flipIncidentEdge(data, vertex))
+			{
+				data.vertexEdges[vertex] = InvalidTrIndex;
+				data.crossingEdges.clear();
+				rebuildDynamicTriangulation(data);
+				return;
+			}
+		}
+
+		// The half-edges pushed by the flips are invalidated by the merge; the hole is checked as a whole below
+		data.pendingEdges.clear();
+		mergeIncidentTriangles(data, vertex);
+
+		// Restore the Delaunay condition inside the hole and along its outline. Since boundary vertices are not surrounded by
+		// triangles on all sides, half-edges are searched from the other vertex; edges between two boundary vertices have no twin.
+		AURORA_FOREACH(const auto& edge, data.crossingEdges)
+		{
+			TrIndex start = isBoundary(edge.first) ? edge.second : edge.first;
+			TrIndex end = isBoundary(edge.first) ? edge.first : edge.second;
+
+			TrIndex unused;
+			TrIndex halfEdge = isBoundary(start) ? InvalidTrIndex : findHalfEdge(data, start, end, unused);
+
+			if (halfEdge != InvalidTrIndex)
+				data.pendingEdges.push_back(halfEdge);
+		}
+
+		data.crossingEdges.clear();
+		restoreDelaunay(data);
+	}
+
+	void moveDynamicVertex(TriangulationData& data, TrIndex vertex, sf::Vector2f position)
+	{
+		assert(!isBoundary(vertex) && isVertexAlive(data, vertex));
+
+		// The vertex can be moved in place if all its triangles keep their orientation
+		bool inPlace = getMaxCoordinate(position) <= data.boundaryExtent;
+
+		const TrIndex first = data.vertexEdges[vertex];
+		TrIndex e = first;
+		do
+		{
+			if (computeOrientation(position, at(data, data.corners[nextHalfEdge(e)]), at(data, data.corners[previousHalfEdge(e)])) >= 0)
+				inPlace = false;
+
+			e = data.twins[previousHalfEdge(e)];
+		}
+		while (inPlace && e != first);
+
+		// Then, only the edges of the vertex' triangles may breach the Delaunay condition
+		if (inPlace)
+		{
+			data.positions[vertex] = position;
+
+			do
+			{
+				data.pendingEdges.push_back(e);
+				data.pendingEdges.push_back(nextHalfEdge(e));
+
+				e = data.twins[previousHalfEdge(e)];
+			}
+			while (e != first);
+
+			restoreDelaunay(data);
+			return;
+		}
+
+		// Otherwise, remove the vertex and insert it again at the new position, together with its constrained edges
+		data.neighborVertices.clear();
+		e = first;
+		do
+		{
+			TrIndex neighbor = data.corners[nextHalfEdge(e)];
+			if (isEdgeConstrained(data, vertex, neighbor))
+				data.neighborVertices.push_back(neighbor);
+
+			e = data.twins[previousHalfEdge(e)];
+		}
+		while (e != first);
+
+		const TrIndex hint = data.corners[nextHalfEdge(first)];
+		removeDynamicVertex(data, vertex);
+
+		data.positions[vertex] = position;
+		insertDynamicVertex(data, vertex, hint);
+
+		AURORA_FOREACH(TrIndex neighbor, data.neighborVertices)
+			insertDynamicEdge(data, vertex, neighbor);
+	}
+
+	void insertDynamicEdge(TriangulationData& data, TrIndex start, TrIndex end)
+	{
+		assert(!isBoundary(start) && isVertexAlive(data, start));
+		assert(!isBoundary(end) && isVertexAlive(data, end));
+		assert(at(data, start) != at(data, end));
+
+		// Keep the constrained edges normalized and sorted, for isEdgeConstrained()
+		std::pair<TrIndex, TrIndex> edge(std::min(start, end), std::max(start, end));
+
+		auto found = std::lower_bound(data.constrainedEdges.begin(), data.constrainedEdges.end(), edge);
+		if (found == data.constrainedEdges.end() || *found != edge)
+			data.constrainedEdges.insert(found, edge);
+
+		recoverConstrainedEdge(data, start, end);
+	}
+
+	void removeDynamicEdge(TriangulationData& data, TrIndex start, TrIndex end)
+	{
+		assert(!isBoundary(start) && isVertexAlive(data, start));
+
+		eraseConstrainedEdge(data, start, end);
+
+		// Without the constraint, the edge may breach the Delaunay condition
+		TrIndex unused;
+		TrIndex halfEdge = findHalfEdge(data, start, end, unused);
+		if (halfEdge != InvalidTrIndex)
+		{
+			data.pendingEdges.push_back(halfEdge);
+			restoreDelaunay(data);
+		}
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Returns the grid cell of the triangulation query that contains point, or the closest cell if point is outside the grid.
+	TrIndex getQueryCell(const TriangulationQueryData& query, sf::Vector2f point)
+	{
+		sf::Vector2f cell = cwiseQuotient(point - query.bounds.min, query.cellSize);
+
+		TrIndex column = static_cast<TrIndex>(std::min(std::max(cell.x, 0.f), static_cast<float>(query.columns - 1)));
+		TrIndex row = static_cast<TrIndex>(std::min(std::max(cell.y, 0.f), static_cast<float>(query.rows - 1)));
+
+		return row * query.columns + column;
+	}
+
+	// Searches the grid cells in rings around the cell of point, for a vertex closer than nearest. Stops when the ring is farther
+	// away than the nearest vertex found so far.
+	void searchQueryGrid(const TriangulationQueryData& query, sf::Vector2f point, TrIndex& nearest, float& nearestDistance)
+	{
+		const TrIndex center = getQueryCell(query, point);
+		const int column = static_cast<int>(center % query.columns);
+		const int row = static_cast<int>(center / query.columns);
+		const int nbRings = static_cast<int>(std::max(query.columns, query.rows));
+		const float ringWidth = std::min(query.cellSize.x, query.cellSize.y);
+
+		// Cells of ring r are at least (r-1) cell widths away from point (also if the point is outside the grid and clamped to it)
+		for (int ring = 0; ring < nbRings; ++ring)
+		{
+			float ringDistance = (ring - 1) * ringWidth;
+			if (ring > 1 && ringDistance * ringDistance > nearestDistance)
+				break;
+
+			for (int y = std::max(row - ring, 0); y <= std::min(row + ring, static_cast<int>(query.rows) - 1); ++y)
+			{
+				// Only the cells on the ring's border are new; in inner rows, skip the cells between the left and right border
+				const int step = (y == row - ring || y == row + ring) ? 1 : 2 * ring;
+				for (int x = column - ring; x <= column + ring; x += step)
+				{
+					if (x < 0 || x >= static_cast<int>(query.columns))
+						continue;
+
+					const TrIndex cell = static_cast<TrIndex>(y) * query.columns + static_cast<TrIndex>(x);
+					for (TrIndex i = query.cellBegins[cell]; i < query.cellBegins[cell + 1]; ++i)
+					{
+						TrIndex vertex = query.cellVertices[i];
+						float distance = squaredLength(at(query.mesh, vertex) - point);
+
+						if (distance < nearestDistance)
+						{
+							nearest = vertex;
+							nearestDistance = distance;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	void buildTriangulationQuery(TriangulationQueryData& query)
+	{
+		TriangulationData& mesh = query.mesh;
+		const TrIndex nbVertices = static_cast<TrIndex>(mesh.positions.size());
+
+		computeInsertionOrder(mesh);
+		triangulateWithBoundary(mesh);
+
+		// Number the triangles that don't touch the boundary, and compute the Voronoi vertices
+		const TrIndex nbTriangles = static_cast<TrIndex>(mesh.firstVertices.size());
+		query.userTriangles.clear();
+		query.meshTriangles.assign(nbTriangles, InvalidTrIndex);
+		query.circumcenters.resize(nbTriangles);
+
+		for (TrIndex t = 0; t < nbTriangles; ++t)
+		{
+			query.circumcenters[t] = computeCircumcircle(mesh, t).midPoint;
+
+			if (!isBoundary(mesh.corners[3*t]) && !isBoundary(mesh.corners[3*t+1]) && !isBoundary(mesh.corners[3*t+2]))
+			{
+				query.meshTriangles[t] = static_cast<TrIndex>(query.userTriangles.size());
+				query.userTriangles.push_back(t);
+			}
+		}
+
+		// Uniform grid with about 4 vertices per cell, each referring to the triangle of a vertex inside it
+		query.bounds = emptyBox();
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices; ++vertex)
+			extendBox(query.bounds, at(mesh, vertex));
+
+		query.columns = std::max<TrIndex>(1, static_cast<TrIndex>(std::sqrt((nbVertices - BoundaryVertexCount) / 4.f)));
+		query.rows = query.columns;
+		query.cellSize.x = std::max((query.bounds.max.x - query.bounds.min.x) / query.columns, std::numeric_limits<float>::min());
+		query.cellSize.y = std::max((query.bounds.max.y - query.bounds.min.y) / query.rows, std::numeric_limits<float>::min());
+
+		// Sort the vertices into the cells: count them per cell, accumulate the counts to cell ends, then fill each cell from its end
+		const TrIndex nbCells = query.columns * query.rows;
+		query.cellBegins.assign(nbCells + 1, 0);
+		for (TrIndex vertex = BoundaryVertexCount; vertex < nbVertices; ++vertex)
+			++query.cellBegins[getQueryCell(query, at(mesh, vertex))];
+
+		for (TrIndex cell = 1; cell <= nbCells; ++cell)
+			query.cellBegins[cell] += query.cellBegins[cell - 1];
+
+		query.cells.assign(nbCells, InvalidTrIndex);
+		query.cellVertices.resize(nbVertices - BoundaryVertexCount);
+		for (TrIndex vertex = nbVertices; vertex-- > BoundaryVertexCount; )
+		{
+			TrIndex cell = getQueryCell(query, at(mesh, vertex));
+
+			query.cellVertices[--query.cellBegins[cell]] = vertex;
+			query.cells[cell] = mesh.vertexEdges[vertex] / 3;
+		}
+
+		// Empty cells take the triangle of the previous cell (or the next one, at the beginning)
+		TrIndex previous = InvalidTrIndex;
+		for (std::size_t i = query.cells.size(); i-- > 0; )
+			previous = (query.cells[i] != InvalidTrIndex) ? query.cells[i] : previous;
+
+		AURORA_FOREACH(TrIndex& cell, query.cells)
+			previous = cell = (cell != InvalidTrIndex) ? cell : previous;
+
+		// Without any vertex, there is only the boundary triangle
+		if (previous == InvalidTrIndex)
+			query.cells.assign(query.cells.size(), 0);
+	}
+
+	TrIndex locateQueryTriangle(const TriangulationQueryData& query, sf::Vector2f point, TrIndex hint)
+	{
+		TrIndex start = (hint < query.userTriangles.size()) ? query.userTriangles[hint] : query.cells[getQueryCell(query, point)];
+
+		std::minstd_rand random;
+		return locateTriangle(query.mesh, point, start, random);
+	}
+
+	TrIndex findNearestQueryVertex(const TriangulationQueryData& query, sf::Vector2f point)
+	{
+		const TriangulationData& mesh = query.mesh;
+
+		// Begin at the closest corner of the triangle that contains the point. Every triangle has at least one non-boundary corner,
+		// unless there are no vertices at all.
+		const TrIndex t = locateQueryTriangle(query, point, InvalidTrIndex);
+
+		TrIndex nearest = InvalidTrIndex;
+		float nearestDistance = std::numeric_limits<float>::max();
+		for (TrIndex e = 3*t; e < 3*t+3; ++e)
+		{
+			TrIndex corner = mesh.corners[e];
+			float distance = squaredLength(at(mesh, corner) - point);
+
+			if (!isBoundary(corner) && distance < nearestDistance)
+			{
+				nearest = corner;
+				nearestDistance = distance;
+			}
+		}
+
+		if (nearest == InvalidTrIndex)
+			return InvalidTrIndex;
+
+		// Greedy walk in the Delaunay graph: a vertex that is not the nearest one always has a neighbor closer to the point
+		for (TrIndex current = InvalidTrIndex; current != nearest; )
+		{
+			current = nearest;
+
+			const TrIndex first = mesh.vertexEdges[current];
+			TrIndex e = first;
+			do
+			{
+				TrIndex neighbor = mesh.corners[nextHalfEdge(e)];
+				float distance = squaredLength(at(mesh, neighbor) - point);
+
+				if (!isBoundary(neighbor) && distance < nearestDistance)
+				{
+					nearest = neighbor;
+					nearestDistance = distance;
+				}
+
+				e = mesh.twins[previousHalfEdge(e)];
+			}
+			while (e != first);
+		}
+
+		// Outside the triangulation, the mesh may lack some Delaunay edges between border vertices, because the boundary triangle is
+		// finite. The walk may then stop early, so the result is completed by a search in the grid around the point.
+		if (query.meshTriangles[t] == InvalidTrIndex)
+			searchQueryGrid(query, point, nearest, nearestDistance);
+
+		return nearest;
+	}
+
+	// ---------------------------------------------------------------------------------------------------------------------------
+
+
+	// Minimal number of vertex slots before unreferenced slots are collected for the first time
+	const TrIndex MinStreamingCollectionSize = 64;
+
+	// Returns the cell column (or row) that contains a coordinate, clamped to the cells.
+	TrIndex getStreamingCellCoordinate(double coordinate, float min, float cellSize, TrIndex nbCells)
+	{
+		double cell = std::floor((coordinate - min) / cellSize);
+		return static_cast<TrIndex>(std::min(std::max(cell, 0.0), static_cast<double>(nbCells - 1)));
+	}
+
+	// Checks whether position is inside the mesh triangle t or on its border.
+	bool isInsideTriangle(const TriangulationData& mesh, TrIndex t, sf::Vector2f position)
+	{
+		for (TrIndex e = 3*t; e < 3*t+3; ++e)
+		{
+			// Clockwise triangle: the inside is on the right of each half-edge
+			if (computeOrientation(at(mesh, mesh.corners[e]), at(mesh, mesh.corners[nextHalfEdge(e)]), position) > 0)
+				return false;
+		}
+
+		return true;
+	}
+
+	// Searches the triangle that contains position, breadth-first through the triangles that overlap the rectangle spanned by two cells:
+	// the cell of position, and a cell with a vertex from whose triangle the search starts. If no cell in the rectangle is finalized,
+	// neither are the triangles overlapping it, so they cover the rectangle and the search succeeds. Returns InvalidTrIndex otherwise.
+	TrIndex searchStreamingCells(StreamingTriangulationData& stream, TrIndex cell, TrIndex startCell, sf::Vector2f position)
+	{
+		const TriangulationData& mesh = stream.mesh;
+
+		const TrIndex minColumn = std::min(cell % stream.columns, startCell % stream.columns);
+		const TrIndex maxColumn = std::max(cell % stream.columns, startCell % stream.columns);
+		const TrIndex minRow = std::min(cell / stream.columns, startCell / stream.columns);
+		const TrIndex maxRow = std::max(cell / stream.columns, startCell / stream.columns);
+
+		for (TrIndex row = minRow; row <= maxRow; ++row)
+		{
+			for (TrIndex column = minColumn; column <= maxColumn; ++column)
+			{
+				if (stream.finalizedCells[row * stream.columns + column])
+					return InvalidTrIndex;
+			}
+		}
+
+		// Enlarge the rectangle a bit, so that rounding errors do not exclude triangles at its border
+		const sf::Vector2f margin = 0.001f * stream.cellSize;
+		const sf::Vector2f rectMin = stream.bounds.min - margin
+			+ cwiseProduct(sf::Vector2f(static_cast<float>(minColumn), static_cast<float>(minRow)), stream.cellSize);
+		const sf::Vector2f rectMax = stream.bounds.min + margin
+			+ cwiseProduct(sf::Vector2f(static_cast<float>(maxColumn + 1), static_cast<float>(maxRow + 1)), stream.cellSize);
+
+		// Marks from earlier searches have smaller numbers, so they need not be reset
+		stream.searchMarks.resize(mesh.firstVertices.size(), 0);
+		const TrIndex number = ++stream.searchNumber;
+
+		const TrIndex start = mesh.vertexEdges[stream.cellVertices[startCell]] / 3;
+		stream.searchQueue.clear();
+		stream.searchQueue.push_back(start);
+		stream.searchMarks[start] = number;
+
+		for (std::size_t i = 0; i < stream.searchQueue.size(); ++i)
+		{
+			const TrIndex t = stream.searchQueue[i];
+
+			EdgeBox box = { at(mesh, mesh.corners[3*t]), at(mesh, mesh.corners[3*t]) };
+			extendBox(box, at(mesh, mesh.corners[3*t+1]));
+			extendBox(box, at(mesh, mesh.corners[3*t+2]));
+
+			if (box.max.x < rectMin.x || box.min.x > rectMax.x || box.max.y < rectMin.y || box.min.y > rectMax.y)
+				continue;
+
+			if (isInsideTriangle(mesh, t, position))
+				return t;
+
+			for (TrIndex e = 3*t; e < 3*t+3; ++e)
+			{
+				const TrIndex twin = mesh.twins[e];
+				if (twin != InvalidTrIndex && stream.searchMarks[twin / 3] != number)
+				{
+					stream.searchMarks[twin / 3] = number;
+					stream.searchQueue.push_back(twin / 3);
+				}
+			}
+		}
+
+		return InvalidTrIndex;
+	}
+
+	// Finds the triangle that contains position, after the walk got stuck at the hole of removed triangles. Searches from a vertex in the
+	// same cell, else from one in a neighbor cell. If there is none, all triangles are tested: one of them contains the position, since
+	// the circumcircles of the removed triangles do not touch its cell.
+	TrIndex searchStreamingTriangle(StreamingTriangulationData& stream, TrIndex cell, sf::Vector2f position)
+	{
+		if (stream.cellVertices[cell] != InvalidTrIndex)
+		{
+			TrIndex t = searchStreamingCells(stream, cell, cell, position);
+			if (t != InvalidTrIndex)
+				return t;
+		}
+
+		const TrIndex column = cell % stream.columns;
+		const TrIndex row = cell / stream.columns;
+
+		for (TrIndex y = (row > 0) ? row - 1 : 0; y <= std::min(row + 1, stream.rows - 1); ++y)
+		{
+			for (TrIndex x = (column > 0) ? column - 1 : 0; x <= std::min(column + 1, stream.columns - 1); ++x)
+			{
+				const TrIndex neighbor = y * stream.columns + x;
+				if (neighbor != cell && stream.cellVertices[neighbor] != InvalidTrIndex)
+				{
+					TrIndex t = searchStreamingCells(stream, cell, neighbor, position);
+					if (t != InvalidTrIndex)
+						return t;
+				}
+			}
+		}
+
+		TrIndex t = 0;
+		while (!isInsideTriangle(stream.mesh, t, position))
+		{
+			++t;
+			assert(t < stream.mesh.firstVertices.size());
+		}
+
+		return t;
+	}
+
+	// Returns a cell that is not finalized and touched by the circumcircle of triangle t (which has no boundary vertex), or
+	// InvalidTrIndex if there is none. In the latter case, no later vertex can be inside the circumcircle, so the triangle is final.
+	TrIndex findBlockingCell(const StreamingTriangulationData& stream, TrIndex t)
+	{
+		const TriangulationData& mesh = stream.mesh;
+		const sf::Vector2f a = at(mesh, mesh.corners[3*t]);
+		const sf::Vector2f b = at(mesh, mesh.corners[3*t+1]);
+		const sf::Vector2f c = at(mesh, mesh.corners[3*t+2]);
+
+		TrIndex minColumn = 0;
+		TrIndex minRow = 0;
+		TrIndex maxColumn = stream.columns - 1;
+		TrIndex maxRow = stream.rows - 1;
+
+		// Compute the circumcircle relative to a. If the triangle is (nearly) flat, the center is inaccurate, and the circle is
+		// assumed to cover all cells. Otherwise, a small margin on the radius absorbs rounding errors.
+		const double bx = double(b.x) - a.x;
+		const double by = double(b.y) - a.y;
+		const double cx = double(c.x) - a.x;
+		const double cy = double(c.y) - a.y;
+		const double cross = bx * cy - by * cx;
+
+		if (std::abs(cross) > 1e-6 * (std::abs(bx * cy) + std::abs(by * cx)))
+		{
+			const double bLength = bx * bx + by * by;
+			const double cLength = cx * cx + cy * cy;
+			const double centerX = (cy * bLength - by * cLength) / (2.0 * cross);
+			const double centerY = (bx * cLength - cx * bLength) / (2.0 * cross);
+			const double radius = std::sqrt(centerX * centerX + centerY * centerY) * (1.0 + 1e-6);
+
+			minColumn = getStreamingCellCoordinate(a.x + centerX - radius, stream.bounds.min.x, stream.cellSize.x, stream.columns);
+			maxColumn = getStreamingCellCoordinate(a.x + centerX + radius, stream.bounds.min.x, stream.cellSize.x, stream.columns);
+			minRow = getStreamingCellCoordinate(a.y + centerY - radius, stream.bounds.min.y, stream.cellSize.y, stream.rows);
+			maxRow = getStreamingCellCoordinate(a.y + centerY + radius, stream.bounds.min.y, stream.cellSize.y, stream.rows);
+		}
+
+		// Scan backwards: when cells are finalized row by row, the triangle waits for the last one, instead of moving from cell to cell
+		for (TrIndex row = maxRow + 1; row-- > minRow; )
+		{
+			for (TrIndex column = maxColumn + 1; column-- > minColumn; )
+			{
+				const TrIndex cell = row * stream.columns + column;
+				if (!stream.finalizedCells[cell])
+					return cell;
+			}
+		}
+
+		return InvalidTrIndex;
+	}
+
+	// Registers triangle t at the cell it waits for. Triangles at the boundary vertices wait until the end of the stream.
+	void linkStreamingTriangle(StreamingTriangulationData& stream, TrIndex t)
+	{
+		const TriangulationData& mesh = stream.mesh;
+
+		TrIndex cell = InvalidTrIndex;
+		if (!isBoundary(mesh.corners[3*t]) && !isBoundary(mesh.corners[3*t+1]) && !isBoundary(mesh.corners[3*t+2]))
+		{
+			// The triangle's corners are on the circumcircle, and at least one of them (the new vertex) is in a cell not finalized
+			cell = findBlockingCell(stream, t);
+			assert(cell != InvalidTrIndex);
+		}
+
+		stream.triangleCells[t] = cell;
+		if (cell != InvalidTrIndex)
+			stream.cellTriangles[cell].push_back(t);
+	}
+
+	// Appends the stream indices of the corners of triangle t to the output.
+	void appendStreamingTriangle(StreamingTriangulationData& stream, TrIndex t)
+	{
+		for (TrIndex e = 3*t; e < 3*t+3; ++e)
+			stream.output.push_back(stream.vertexIds[stream.mesh.corners[e]]);
+	}
+
+	// Removes triangle t from the mesh, which gets a hole there. The last triangle moves to index t.
+	void removeStreamingTriangle(StreamingTriangulationData& stream, TrIndex t)
+	{
+		TriangulationData& mesh = stream.mesh;
+		const TrIndex last = static_cast<TrIndex>(mesh.firstVertices.size()) - 1;
+
+		// If walks began here, let them begin at a remaining neighbor, which is close to the next vertices. The boundary triangles are
+		// never removed, so there is always a triangle 0 as a last resort.
+		TrIndex lastTriangle = stream.lastTriangle;
+		if (lastTriangle == t)
+			lastTriangle = 0;
+
+		for (TrIndex e = 3*t; e < 3*t+3; ++e)
+		{
+			if (mesh.twins[e] != InvalidTrIndex)
+			{
+				if (stream.lastTriangle == t)
+					lastTriangle = mesh.twins[e] / 3;
+
+				mesh.twins[mesh.twins[e]] = InvalidTrIndex;
+			}
+		}
+
+		removeTriangle(mesh, t);
+		stream.triangleCells[t] = stream.triangleCells[last];
+		stream.triangleCells.pop_back();
+
+		// The moved triangle must be found at its new index
+		if (t != last && stream.triangleCells[t] != InvalidTrIndex)
+			stream.cellTriangles[stream.triangleCells[t]].push_back(t);
+
+		stream.lastTriangle = (lastTriangle == last) ? t : lastTriangle;
+	}
+
+	// Determines the vertex slots that no triangle refers to any more, and makes them available for new vertices.
+	void collectStreamingVertices(StreamingTriangulationData& stream)
+	{
+		const TriangulationData& mesh = stream.mesh;
+		const TrIndex nbVertices = static_cast<TrIndex>(mesh.positions.size());
+
+		stream.referenced.assign(nbVertices, 0);
+		AURORA_FOREACH(TrIndex corner, mesh.corners)
+			stream.referenced[corner] = 1;
+
+		stream.freeVertices.clear();
+		for (TrIndex vertex = nbVertices; vertex-- > BoundaryVertexCount; )
+		{
+			if (!stream.referenced[vertex])
+				stream.freeVertices.push_back(vertex);
+		}
+
+		// Collect again when the number of slots has doubled, so that the amortized cost per vertex is constant
+		const TrIndex nbReferenced = nbVertices - static_cast<TrIndex>(stream.freeVertices.size());
+		stream.collectionSize = std::max(2 * nbReferenced, MinStreamingCollectionSize);
+	}
+
+	void resetStreamingTriangulation(StreamingTriangulationData& stream, EdgeBox bounds, TrIndex columns, TrIndex rows)
+	{
+		assert(columns > 0 && rows > 0);
+		assert(bounds.min.x < bounds.max.x && bounds.min.y < bounds.max.y);
+
+		// The boundary triangle covers the whole region from the beginning
+		TriangulationData& mesh = stream.mesh;
+		resetTriangulation(mesh);
+		mesh.boundaryExtent = std::max(getMaxCoordinate(bounds.min), getMaxCoordinate(bounds.max));
+		setBoundaryPositions(mesh);
+
+		mesh.vertexEdges.assign(BoundaryVertexCount, InvalidTrIndex);
+		mesh.nextVertices.assign(BoundaryVertexCount, InvalidTrIndex);
+		mesh.vertexTriangles.assign(BoundaryVertexCount, InvalidTrIndex);
+		setTriangle(mesh, appendTriangle(mesh), 0, 1, 2);
+
+		stream.vertexIds.assign(BoundaryVertexCount, 0);
+		stream.freeVertices.clear();
+		stream.triangleCells.assign(1, InvalidTrIndex);
+		stream.cellTriangles.clear();
+		stream.cellTriangles.resize(columns * rows);
+		stream.finalizedCells.assign(columns * rows, 0);
+		stream.cellVertices.assign(columns * rows, InvalidTrIndex);
+		stream.bounds = bounds;
+		stream.cellSize = cwiseQuotient(bounds.max - bounds.min, sf::Vector2f(static_cast<float>(columns), static_cast<float>(rows)));
+		stream.columns = columns;
+		stream.rows = rows;
+		stream.lastTriangle = 0;
+		stream.collectionSize = MinStreamingCollectionSize;
+		stream.searchMarks.clear();
+		stream.searchNumber = 0;
+		stream.nextVertexId = 0;
+	}
+
+	TrIndex getStreamingCell(const StreamingTriangulationData& stream, sf::Vector2f position)
+	{
+		const TrIndex column = getStreamingCellCoordinate(position.x, stream.bounds.min.x, stream.cellSize.x, stream.columns);
+		const TrIndex row = getStreamingCellCoordinate(position.y, stream.bounds.min.y, stream.cellSize.y, stream.rows);
+
+		return row * stream.columns + column;
+	}
+
+	std::uint32_t insertStreamingVertex(StreamingTriangulationData& stream, sf::Vector2f position)
+	{
+		assert(position.x >= stream.bounds.min.x && position.x <= stream.bounds.max.x);
+		assert(position.y >= stream.bounds.min.y && position.y <= stream.bounds.max.y);
+		const TrIndex cell = getStreamingCell(stream, position);
+		assert(!stream.finalizedCells[cell]);
+
+		TriangulationData& mesh = stream.mesh;
+		if (stream.freeVertices.empty() && mesh.positions.size() >= stream.collectionSize)
+			collectStreamingVertices(stream);
+
+		TrIndex vertex;
+		if (stream.freeVertices.empty())
+		{
+			vertex = static_cast<TrIndex>(mesh.positions.size());
+			mesh.positions.push_back(position);
+			mesh.vertexEdges.push_back(InvalidTrIndex);
+			mesh.nextVertices.push_back(InvalidTrIndex);
+			mesh.vertexTriangles.push_back(InvalidTrIndex);
+			stream.vertexIds.push_back(0);
+		}
+		else
+		{
+			vertex = stream.freeVertices.back();
+			stream.freeVertices.pop_back();
+			mesh.positions[vertex] = position;
+		}
+
+		const std::uint32_t id = stream.nextVertexId++;
+		stream.vertexIds[vertex] = id;
+
+		// Walk from the previous vertex in the same cell, or from the previous vertex at all. The walk gets stuck if it reaches the hole of
+		// removed triangles in the direction of position; then the triangle is searched locally.
+		TrIndex start = stream.lastTriangle;
+		if (stream.cellVertices[cell] != InvalidTrIndex)
+			start = mesh.vertexEdges[stream.cellVertices[cell]] / 3;
+
+		std::minstd_rand random(vertex);
+		TrIndex t = locateTriangle(mesh, position, start, random);
+		if (!isInsideTriangle(mesh, t, position))
+			t = searchStreamingTriangle(stream, cell, position);
+
+		mesh.vertexTriangles[vertex] = t;
+		insertPoint(mesh, vertex);
+
+		// The insertion has only created or changed triangles at the new vertex
+		stream.triangleCells.resize(mesh.firstVertices.size(), InvalidTrIndex);
+
+		const TrIndex first = mesh.vertexEdges[vertex];
+		TrIndex e = first;
+		do
+		{
+			linkStreamingTriangle(stream, e / 3);
+			e = mesh.twins[previousHalfEdge(e)];
+		}
+		while (e != first);
+
+		stream.lastTriangle = first / 3;
+		stream.cellVertices[cell] = vertex;
+		return id;
+	}
+
+	void finalizeStreamingCell(StreamingTriangulationData& stream, TrIndex cell)
+	{
+		assert(cell < stream.finalizedCells.size() && !stream.finalizedCells[cell]);
+		stream.finalizedCells[cell] = 1;
+		stream.cellVertices[cell] = InvalidTrIndex;
+
+		// Entries are outdated if the triangle has changed its index or cell since. The list grows during the loop when a triangle
+		// waiting for this cell is moved to the index of a removed one.
+		std::vector<TrIndex>& waiting = stream.cellTriangles[cell];
+		for (std::size_t i = 0; i < waiting.size(); ++i)
+		{
+			const TrIndex t = waiting[i];
+			if (t >= stream.triangleCells.size() || stream.triangleCells[t] != cell)
+				continue;
+
+			const TrIndex next = findBlockingCell(stream, t);
+			if (next == InvalidTrIndex)
+			{
+				appendStreamingTriangle(stream, t);
+				removeStreamingTriangle(stream, t);
+			}
+			else
+			{
+				stream.triangleCells[t] = next;
+				stream.cellTriangles[next].push_back(t);
+			}
+		}
+
+		std::vector<TrIndex>().swap(waiting);
+	}
+
+	void finishStreamingTriangulation(StreamingTriangulationData& stream)
+	{
+		const TriangulationData& mesh = stream.mesh;
+		for (TrIndex t = 0; t < mesh.firstVertices.size(); ++t)
+		{
+			if (!isBoundary(mesh.corners[3*t]) && !isBoundary(mesh.corners[3*t+1]) && !isBoundary(mesh.corners[3*t+2]))
+				appendStreamingTriangle(stream, t);
+		}
+
+		resetStreamingTriangulation(stream, stream.bounds, stream.columns, stream.rows);
+	}
+
+} // namespace detail
+
+// ---------------------------------------------------------------------------------------------------------------------------
+
+
+Triangulator::Triangulator()
+: mData()
+{
+}
+
+void Triangulator::setThreadCount(unsigned int threadCount)
+{
+	mParallel.threadCount = threadCount;
+}
+
+void Triangulator::releaseMemory()
+{
+	detail::TriangulationData empty;
+	std::swap(mData, empty);
+
+	detail::ParallelTriangulationData emptyParallel;
+	emptyParallel.threadCount = mParallel.threadCount;
+	std::swap(mParallel, emptyParallel);
+
+	detail::BatchTriangulationData emptyBatch;
+	std::swap(mBatch, emptyBatch);
+}
+
 } // namespace thor
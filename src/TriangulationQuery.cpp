@@ -0,0 +1,86 @@
+/////////////////////////////////////////////////////////////////////////////////
+//
+// Thor C++ Library
+// Copyright (c) 2011-2022 Jan Haller
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+/////////////////////////////////////////////////////////////////////////////////
+
+#include <Thor/Math/TriangulationQuery.hpp>
+
+#include <cassert>
+
+
+namespace thor
+{
+
+TriangulationQuery::TriangulationQuery()
+: mData()
+{
+	detail::resetTriangulation(mData.mesh);
+	detail::buildTriangulationQuery(mData);
+}
+
+std::uint32_t TriangulationQuery::getTriangleCount() const
+{
+	return static_cast<std::uint32_t>(mData.userTriangles.size());
+}
+
+std::uint32_t TriangulationQuery::getTriangleCorner(std::uint32_t triangle, unsigned int corner) const
+{
+	assert(triangle < mData.userTriangles.size() && corner < 3);
+
+	return mData.mesh.corners[3 * mData.userTriangles[triangle] + corner] - detail::BoundaryVertexCount;
+}
+
+std::uint32_t TriangulationQuery::getAdjacentTriangle(std::uint32_t triangle, unsigned int edge) const
+{
+	assert(triangle < mData.userTriangles.size() && edge < 3);
+
+	const detail::TrIndex twin = mData.mesh.twins[3 * mData.userTriangles[triangle] + edge];
+	const detail::TrIndex neighbor = mData.meshTriangles[twin / 3];
+
+	return (neighbor == detail::InvalidTrIndex) ? NoAdjacentTriangle : neighbor;
+}
+
+std::uint32_t TriangulationQuery::locateTriangle(sf::Vector2f point, std::uint32_t hint) const
+{
+	const detail::TrIndex t = detail::locateQueryTriangle(mData, point, hint);
+	const detail::TrIndex triangle = mData.meshTriangles[t];
+
+	return (triangle == detail::InvalidTrIndex) ? NoTriangle : triangle;
+}
+
+std::uint32_t TriangulationQuery::findNearestVertex(sf::Vector2f point) const
+{
+	const detail::TrIndex vertex = detail::findNearestQueryVertex(mData, point);
+	assert(vertex != detail::InvalidTrIndex);
+
+	return vertex - detail::BoundaryVertexCount;
+}
+
+sf::Vector2f TriangulationQuery::getCircumcenter(std::uint32_t triangle) const
+{
+	assert(triangle < mData.userTriangles.size());
+
+	return mData.circumcenters[mData.userTriangles[triangle]];
+}
+
+} // namespace thor